@@ -2873,7 +2873,13 @@ Amr::regrid (int  lbase,
             new_dmap[lev] = makeLoadBalanceDistributionMap(lev, time, new_grid_places[lev]);
         }
         else if (new_dmap[lev].empty()) {
-	    new_dmap[lev].define(new_grid_places[lev]);
+            if (incremental_regrid && amr_level[lev]) {
+                new_dmap[lev] = DistributionMapping::makeIncremental(new_grid_places[lev],
+                                                                     amr_level[lev]->boxArray(),
+                                                                     amr_level[lev]->DistributionMap());
+            } else {
+                new_dmap[lev].define(new_grid_places[lev]);
+            }
 	}
 
         AmrLevel* a = (*levelbld)(*this,lev,Geom(lev),new_grid_places[lev],
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <limits>
+#include <map>
 
 #include <AMReX_AmrLevel.H>
 #include <AMReX_Derive.H>
@@ -168,7 +169,7 @@ AmrLevel::writePlotFile (const std::string& dir,
 	}
     }
 
-    std::vector<std::string> derive_names;
+    Vector<std::string> derive_names;
     const std::list<DeriveRec>& dlist = derive_lst.dlist();
     for (std::list<DeriveRec>::const_iterator it = dlist.begin();
 	 it != dlist.end();
@@ -333,11 +334,26 @@ AmrLevel::writePlotFile (const std::string& dir,
     // derived
     if (derive_names.size() > 0)
     {
-	for (auto const& dname : derive_names)
-	{
-            derive(dname, cur_time, plotMF, cnt);
-	    cnt++;
-	}
+        // Off by default: the batched version bypasses any override of
+        // the single variable derive() for quantities in derive_lst.
+        int plot_derive_batch = 0;
+        {
+            ParmParse pp("amr");
+            pp.query("plot_derive_batch", plot_derive_batch);
+        }
+        if (plot_derive_batch)
+        {
+            derive(derive_names, cur_time, plotMF, cnt);
+            cnt += derive_names.size();
+        }
+        else
+        {
+            for (auto const& dname : derive_names)
+            {
+                derive(dname, cur_time, plotMF, cnt);
+                cnt++;
+            }
+        }
     }
 
 #ifdef AMREX_USE_EB
@@ -1592,31 +1608,23 @@ AmrLevel::FillCoarsePatch (MultiFab& mf,
 	    FillPatch(clev,crseMF,0,time,idx,SComp,NComp,0);
 	}
 
+        Vector<InterpPatch> patches(mf.local_size());
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
 	for (MFIter mfi(mf); mfi.isValid(); ++mfi)
 	{
-            const Box& dbx = amrex::grow(mfi.validbox(),nghost) & domain_g;
-	    
-            Vector<BCRec> bcr(ncomp);
-	    
-            amrex::setBC(dbx,pdomain,SComp,0,NComp,desc.getBCs(),bcr);
-
-	    mapper->interp(crseMF[mfi],
-			   0,
-			   mf[mfi],
-			   DComp,
-			   NComp,
-			   dbx,
-			   crse_ratio,
-			   cgeom,
-			   geom,
-			   bcr,
-			   SComp,
-			   idx, RunOn::Gpu);
+            InterpPatch& p = patches[mfi.LocalIndex()];
+            p.crse = &crseMF[mfi];
+            p.fine = &mf[mfi];
+            p.fine_region = amrex::grow(mfi.validbox(),nghost) & domain_g;
+            p.bcr.resize(ncomp);
+            amrex::setBC(p.fine_region,pdomain,SComp,0,NComp,desc.getBCs(),p.bcr);
 	}
 
+        mapper->BatchInterp(patches, 0, DComp, NComp, crse_ratio, cgeom, geom,
+                            SComp, idx, RunOn::Gpu);
+
         if (nghost > 0) {
             StateDataPhysBCFunct physbcf(state[idx],SComp,geom);
             physbcf.FillBoundary(mf, DComp, NComp, mf.nGrowVect(), time, SComp);
@@ -1826,11 +1834,8 @@ AmrLevel::derive (const std::string& name, Real time, MultiFab& mf, int dcomp)
 #endif
             for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
-                const Box& bx = mfi.growntilebox();
-                FArrayBox& derfab = mf[mfi];
-                FArrayBox const& datafab = srcMF[mfi];
-                const int dncomp = rec->numDerive();
-                rec->derFuncFab()(bx, derfab, dcomp, dncomp, datafab, geom, time, rec->getBC(), level);
+                derive_fab(*rec, mfi.growntilebox(), mf[mfi], dcomp, srcMF[mfi],
+                           index, time, mfi.index());
             }
         }
         else
@@ -1841,83 +1846,14 @@ AmrLevel::derive (const std::string& name, Real time, MultiFab& mf, int dcomp)
 #endif
         for (MFIter mfi(mf,true); mfi.isValid(); ++mfi)
         {
-            int         idx     = mfi.index();
-            Real*       ddat    = mf[mfi].dataPtr(dcomp);
-            const int*  dlo     = mf[mfi].loVect();
-            const int*  dhi     = mf[mfi].hiVect();
-            const Box&  gtbx    = mfi.growntilebox();
-            const int*  lo      = gtbx.loVect();
-            const int*  hi      = gtbx.hiVect();
-            int         n_der   = rec->numDerive();
-            Real*       cdat    = srcMF[mfi].dataPtr();
-            const int*  clo     = srcMF[mfi].loVect();
-            const int*  chi     = srcMF[mfi].hiVect();
-            int         n_state = rec->numState();
-            const int*  dom_lo  = state[index].getDomain().loVect();
-            const int*  dom_hi  = state[index].getDomain().hiVect();
-            const Real* dx      = geom.CellSize();
-            const int*  bcr     = rec->getBC();
-            const RealBox& temp = RealBox(gtbx,geom.CellSize(),geom.ProbLo());
-            const Real* xlo     = temp.lo();
-            Real        dt      = parent->dtLevel(level);
-
-            if (rec->derFunc() != static_cast<DeriveFunc>(0)){
-               rec->derFunc()(ddat,AMREX_ARLIM(dlo),AMREX_ARLIM(dhi),&n_der,
-                              cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),&n_state,
-                              lo,hi,dom_lo,dom_hi,dx,xlo,&time,&dt,bcr,
-                              &level,&idx);
-            } else if (rec->derFunc3D() != static_cast<DeriveFunc3D>(0)){
-               const int *bc3D = rec->getBC3D();
-               rec->derFunc3D()(ddat,AMREX_ARLIM_3D(dlo),AMREX_ARLIM_3D(dhi),&n_der,
-                                cdat,AMREX_ARLIM_3D(clo),AMREX_ARLIM_3D(chi),&n_state,
-                                AMREX_ARLIM_3D(lo),AMREX_ARLIM_3D(hi),
-                                AMREX_ARLIM_3D(dom_lo),AMREX_ARLIM_3D(dom_hi),
-                                AMREX_ZFILL(dx),AMREX_ZFILL(xlo),
-                                &time,&dt,
-                                bc3D,
-                                &level,&idx);
-            } else {
-               amrex::Error("AmrLevel::derive: no function available");
-            }
+            derive_fab(*rec, mfi.growntilebox(), mf[mfi], dcomp, srcMF[mfi],
+                       index, time, mfi.index());
         }
 #else
         for (MFIter mfi(srcMF); mfi.isValid(); ++mfi)
         {
-            int         idx     = mfi.index();
-            Real*       ddat    = mf[mfi].dataPtr(dcomp);
-            const int*  dlo     = mf[mfi].loVect();
-            const int*  dhi     = mf[mfi].hiVect();
-            int         n_der   = rec->numDerive();
-            Real*       cdat    = srcMF[mfi].dataPtr();
-            const int*  clo     = srcMF[mfi].loVect();
-            const int*  chi     = srcMF[mfi].hiVect();
-            int         n_state = rec->numState();
-            const int*  dom_lo  = state[index].getDomain().loVect();
-            const int*  dom_hi  = state[index].getDomain().hiVect();
-            const Real* dx      = geom.CellSize();
-            const int*  bcr     = rec->getBC();
-            const RealBox& temp = RealBox(mf[mfi].box(),geom.CellSize(),geom.ProbLo());
-            const Real* xlo     = temp.lo();
-            Real        dt      = parent->dtLevel(level);
-
-            if (rec->derFunc() != static_cast<DeriveFunc>(0)){
-               rec->derFunc()(ddat,AMREX_ARLIM(dlo),AMREX_ARLIM(dhi),&n_der,
-                              cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),&n_state,
-                              dlo,dhi,dom_lo,dom_hi,dx,xlo,&time,&dt,bcr,
-                              &level,&idx);
-            } else if (rec->derFunc3D() != static_cast<DeriveFunc3D>(0)){
-               const int *bc3D = rec->getBC3D();
-               rec->derFunc3D()(ddat,AMREX_ARLIM_3D(dlo),AMREX_ARLIM_3D(dhi),&n_der,
-                                cdat,AMREX_ARLIM_3D(clo),AMREX_ARLIM_3D(chi),&n_state,
-                                AMREX_ARLIM_3D(dlo),AMREX_ARLIM_3D(dhi),
-                                AMREX_ARLIM_3D(dom_lo),AMREX_ARLIM_3D(dom_hi),
-                                AMREX_ZFILL(dx),AMREX_ZFILL(xlo),
-                                &time,&dt,
-                                bc3D,
-                                &level,&idx);
-            } else {
-               amrex::Error("AmrLevel::derive: no function available");
-            }
+            derive_fab(*rec, mf[mfi].box(), mf[mfi], dcomp, srcMF[mfi],
+                       index, time, mfi.index());
         }
 #endif
         }
@@ -1933,6 +1869,222 @@ AmrLevel::derive (const std::string& name, Real time, MultiFab& mf, int dcomp)
     }
 }
 
+void
+AmrLevel::derive (const Vector<std::string>& names, Real time, MultiFab& mf, int dcomp)
+{
+    BL_PROFILE("AmrLevel::derive(names)");
+
+    const int ngrow = mf.nGrow();
+    const int nnames = names.size();
+
+    BL_ASSERT(dcomp + nnames <= mf.nComp());
+
+    //
+    // The union of the components and the maximal number of ghost cells
+    // needed from each state type.
+    //
+    std::map<int,std::pair<int,int> > comp_range;
+    std::map<int,int> ngrow_state;
+    Vector<const DeriveRec*> recs(nnames, nullptr);
+    Vector<int> rec_ngrow(nnames, 0);
+
+    for (int i = 0; i < nnames; ++i)
+    {
+        int index, scomp, ncomp;
+        if (isStateVariable(names[i],index,scomp)) continue;
+
+        const DeriveRec* rec = derive_lst.get(names[i]);
+        if (rec == nullptr) continue;
+        recs[i] = rec;
+
+        rec->getRange(0,index,scomp,ncomp);
+        {
+            Box bx0 = state[index].boxArray()[0];
+            Box bx1 = rec->boxMap()(bx0);
+            rec_ngrow[i] = ngrow + bx0.smallEnd(0) - bx1.smallEnd(0);
+        }
+
+        for (int k = 0; k < rec->numRange(); ++k)
+        {
+            rec->getRange(k,index,scomp,ncomp);
+            auto it = comp_range.find(index);
+            if (it == comp_range.end()) {
+                comp_range[index] = std::make_pair(scomp, scomp+ncomp-1);
+                ngrow_state[index] = rec_ngrow[i];
+            } else {
+                it->second.first  = std::min(it->second.first , scomp);
+                it->second.second = std::max(it->second.second, scomp+ncomp-1);
+                ngrow_state[index] = std::max(ngrow_state[index], rec_ngrow[i]);
+            }
+        }
+    }
+
+    //
+    // One FillPatch per state type.
+    //
+    std::map<int,MultiFab> srcMF;
+    for (auto const& kv : comp_range)
+    {
+        const int index = kv.first;
+        const int scomp = kv.second.first;
+        const int ncomp = kv.second.second - scomp + 1;
+        const int ng = ngrow_state[index];
+        MultiFab& smf = srcMF[index];
+        smf.define(state[index].boxArray(), dmap, ncomp, ng, MFInfo(), *m_factory);
+        FillPatch(*this,smf,ng,time,index,scomp,ncomp,0);
+    }
+
+    //
+    // A DeriveRec whose components are contiguous in a single state type
+    // reads an alias of the filled data.  Otherwise, its components are
+    // gathered into a temporary fab.
+    //
+    Vector<int> rec_index(nnames, -1);
+    Vector<int> rec_alias(nnames, -1);
+    bool any_fab = false, any_fort = false;
+    for (int i = 0; i < nnames; ++i)
+    {
+        const DeriveRec* rec = recs[i];
+        if (rec == nullptr) continue;
+
+        if (rec->derFuncFab() != nullptr) {
+            any_fab = true;
+        } else {
+            any_fort = true;
+        }
+
+        int index, scomp, ncomp;
+        rec->getRange(0,index,scomp,ncomp);
+        rec_index[i] = index;
+        const int scomp0 = scomp;
+        bool contiguous = true;
+        for (int k = 1, nc = ncomp; k < rec->numRange(); nc += ncomp, ++k)
+        {
+            rec->getRange(k,index,scomp,ncomp);
+            if (index != rec_index[i] || scomp != scomp0+nc) contiguous = false;
+        }
+        if (contiguous) {
+            rec_alias[i] = scomp0 - comp_range[rec_index[i]].first;
+        }
+    }
+
+    //
+    // The DeriveFuncFab functions are evaluated in a tiled, threaded pass
+    // and the Fortran ones in a separate pass that, as in the single
+    // variable version, is only tiled when CRSEGRNDOMP is set.
+    //
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        const bool fab_pass = (pass == 0);
+        if (srcMF.empty() || !(fab_pass ? any_fab : any_fort)) continue;
+
+#if defined(AMREX_CRSEGRNDOMP) || (!defined(AMREX_XSDK) && defined(CRSEGRNDOMP))
+        const bool tiling = true;
+#else
+        const bool tiling = fab_pass;
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel if (tiling && Gpu::notInLaunchRegion())
+#endif
+        {
+            FArrayBox tmpfab;
+            for (MFIter mfi(mf, tiling && TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.growntilebox();
+                for (int i = 0; i < nnames; ++i)
+                {
+                    const DeriveRec* rec = recs[i];
+                    if (rec == nullptr || (rec->derFuncFab() != nullptr) != fab_pass) continue;
+
+                    if (rec_alias[i] >= 0)
+                    {
+                        FArrayBox datafab(srcMF.at(rec_index[i])[mfi], amrex::make_alias,
+                                          rec_alias[i], rec->numState());
+                        derive_fab(*rec, bx, mf[mfi], dcomp+i, datafab,
+                                   rec_index[i], time, mfi.index());
+                    }
+                    else
+                    {
+                        const Box& dbx = amrex::grow(bx, rec_ngrow[i]-ngrow);
+                        tmpfab.resize(dbx, rec->numState());
+                        Elixir eli = tmpfab.elixir();
+                        int index, scomp, ncomp;
+                        for (int k = 0, dc = 0; k < rec->numRange(); k++, dc += ncomp)
+                        {
+                            rec->getRange(k,index,scomp,ncomp);
+                            tmpfab.copy<RunOn::Device>(srcMF.at(index)[mfi], dbx,
+                                                       scomp - comp_range.at(index).first,
+                                                       dbx, dc, ncomp);
+                        }
+                        derive_fab(*rec, bx, mf[mfi], dcomp+i, tmpfab,
+                                   rec_index[i], time, mfi.index());
+                    }
+                }
+            }
+        }
+    }
+
+    //
+    // State variables and names unknown to the derive list.  Doing these
+    // last preserves the order in which components of mf are written.
+    //
+    for (int i = 0; i < nnames; ++i)
+    {
+        if (recs[i] == nullptr) {
+            derive(names[i], time, mf, dcomp+i);
+        }
+    }
+}
+
+void
+AmrLevel::derive_fab (const DeriveRec& rec, const Box& bx, FArrayBox& derfab, int dcomp,
+                      const FArrayBox& datafab, int index, Real time, int idx)
+{
+    if (rec.derFuncFab() != nullptr)
+    {
+        rec.derFuncFab()(bx, derfab, dcomp, rec.numDerive(), datafab, geom, time, rec.getBC(), level);
+        return;
+    }
+
+    Real*       ddat    = derfab.dataPtr(dcomp);
+    const int*  dlo     = derfab.loVect();
+    const int*  dhi     = derfab.hiVect();
+    const int*  lo      = bx.loVect();
+    const int*  hi      = bx.hiVect();
+    int         n_der   = rec.numDerive();
+    Real*       cdat    = const_cast<Real*>(datafab.dataPtr());
+    const int*  clo     = datafab.loVect();
+    const int*  chi     = datafab.hiVect();
+    int         n_state = rec.numState();
+    const int*  dom_lo  = state[index].getDomain().loVect();
+    const int*  dom_hi  = state[index].getDomain().hiVect();
+    const Real* dx      = geom.CellSize();
+    const int*  bcr     = rec.getBC();
+    const RealBox& temp = RealBox(bx,geom.CellSize(),geom.ProbLo());
+    const Real* xlo     = temp.lo();
+    Real        dt      = parent->dtLevel(level);
+
+    if (rec.derFunc() != static_cast<DeriveFunc>(0)){
+       rec.derFunc()(ddat,AMREX_ARLIM(dlo),AMREX_ARLIM(dhi),&n_der,
+                     cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),&n_state,
+                     lo,hi,dom_lo,dom_hi,dx,xlo,&time,&dt,bcr,
+                     &level,&idx);
+    } else if (rec.derFunc3D() != static_cast<DeriveFunc3D>(0)){
+       const int *bc3D = rec.getBC3D();
+       rec.derFunc3D()(ddat,AMREX_ARLIM_3D(dlo),AMREX_ARLIM_3D(dhi),&n_der,
+                       cdat,AMREX_ARLIM_3D(clo),AMREX_ARLIM_3D(chi),&n_state,
+                       AMREX_ARLIM_3D(lo),AMREX_ARLIM_3D(hi),
+                       AMREX_ARLIM_3D(dom_lo),AMREX_ARLIM_3D(dom_hi),
+                       AMREX_ZFILL(dx),AMREX_ZFILL(xlo),
+                       &time,&dt,
+                       bc3D,
+                       &level,&idx);
+    } else {
+       amrex::Error("AmrLevel::derive: no function available");
+    }
+}
+
 //! Update the distribution maps in StateData based on the size of the map
 void
 AmrLevel::UpdateDistributionMaps ( DistributionMapping& update_dmap )
@@ -2211,6 +2363,27 @@ AmrLevel::FillPatch (AmrLevel& amrlevel,
 {
     BL_ASSERT(dcomp+ncomp-1 <= leveldata.nComp());
     BL_ASSERT(boxGrow <= leveldata.nGrow());
+
+    if (boxGrow == 0 && amrlevel.parent->incrementalRegrid()
+        && leveldata.boxArray() != amrlevel.boxArray())
+    {
+        //
+        // Filling a regridded level: reuse the boxes that have not changed,
+        // and only fillpatch the others.
+        //
+        Vector<MultiFab*> smf;
+        Vector<Real> stime;
+        amrlevel.state[index].getData(smf,stime,time);
+
+        amrex::FillPatchIncremental(leveldata, time, smf, stime, scomp, dcomp, ncomp,
+            [&] (MultiFab& dst, int dstcomp)
+            {
+                FillPatchIterator fpi(amrlevel, dst, 0, time, index, scomp, ncomp);
+                MultiFab::Copy(dst, fpi.get_mf(), 0, dstcomp, ncomp, 0);
+            });
+        return;
+    }
+
     FillPatchIterator fpi(amrlevel, leveldata, boxGrow, time, index, scomp, ncomp);
     const MultiFab& mf_fillpatched = fpi.get_mf();
     MultiFab::Copy(leveldata, mf_fillpatched, 0, dcomp, ncomp, boxGrow);
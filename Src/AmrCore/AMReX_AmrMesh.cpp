@@ -354,6 +354,10 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
 	pp.query("refine_grid_layout", refine_grid_layout);
     }
 
+    pp.query("distributed_clustering", distributed_clustering);
+
+    pp.query("incremental_regrid", incremental_regrid);
+
     pp.query("check_input", check_input);
 
     finest_level = -1;
@@ -691,13 +695,55 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
         //
         tags.setVal(p_n_comp[levc],TagBox::CLEAR);
         //
-        // Create initial cluster containing all tagged points.
+        // Efficient properly nested Clusters are constructed from the
+        // tagged points, either on every process for all tagged points, or
+        // from the tagged points of each process and merged.
         //
-	Vector<IntVect> tagvec;
-	tags.collate(tagvec);
-        tags.clear();
+        BoxList new_bx;
+        if (distributed_clustering)
+        {
+            // the clusters are merged with the numbers of their tags, so
+            // a tag must not be on more than one process
+            tags.removeDuplicates();
+
+            Vector<IntVect> tagvec;
+            tags.local_collate(tagvec);
+            tags.clear();
+
+            BoxDomain bd;
+            bd.add(p_n[levc]);
+            new_bx = ParallelCluster(tagvec, grid_eff, use_new_chop, bd);
+        }
+        else
+        {
+            //
+            // Create initial cluster containing all tagged points.
+            //
+            Vector<IntVect> tagvec;
+            tags.collate(tagvec);
+            tags.clear();
 
-        if (tagvec.size() > 0)
+            if (tagvec.size() > 0)
+            {
+                //
+                // Construct initial cluster.
+                //
+                ClusterList clist(&tagvec[0], tagvec.size());
+                if (use_new_chop)
+                {
+                    clist.new_chop(grid_eff);
+                } else {
+                    clist.chop(grid_eff);
+                }
+                BoxDomain bd;
+                bd.add(p_n[levc]);
+                clist.intersect(bd);
+                bd.clear();
+                clist.boxList(new_bx);
+            }
+        }
+
+        if (new_bx.size() > 0)
         {
             //
             // Created new level, now generate efficient grids.
@@ -706,25 +752,9 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
                 new_finest = std::max(new_finest,levf);
 	    }
             //
-            // Construct initial cluster.
-            //
-            ClusterList clist(&tagvec[0], tagvec.size());
-            if (use_new_chop)
-            {
-               clist.new_chop(grid_eff);
-            } else {
-               clist.chop(grid_eff);
-            }
-            BoxDomain bd;
-            bd.add(p_n[levc]);
-            clist.intersect(bd);
-            bd.clear();
-            //
             // Efficient properly nested Clusters have been constructed
             // now generate list of grids at level levf.
             //
-            BoxList new_bx;
-            clist.boxList(new_bx);
             new_bx.refine(bf_lev[levc]);
             new_bx.simplify();
             BL_ASSERT(new_bx.isDisjoint());
@@ -1019,6 +1049,8 @@ std::ostream& operator<< (std::ostream& os, AmrMesh const& amr_mesh)
     os << "  check_input = " << amr_mesh.check_input  << "\n";
     os << "  use_new_chop = " << amr_mesh.use_new_chop << "\n";
     os << "  iterate_on_new_grids = " << amr_mesh.iterate_on_new_grids << "\n";
+    os << "  distributed_clustering = " << amr_mesh.distributed_clustering << "\n";
+    os << "  incremental_regrid = " << amr_mesh.incremental_regrid << "\n";
     return os;
 }
 
@@ -5,6 +5,7 @@
 #include <AMReX_BoxDomain.H>
 #include <AMReX_Vector.H>
 #include <AMReX_Array.H>
+#include <AMReX_ParallelDescriptor.H>
 
 namespace amrex {
 
@@ -519,6 +520,22 @@ ClusterList::boxList (BoxList& blst) const
     }
 }
 
+void
+ClusterList::boxList (BoxList& blst, Vector<Long>& ntags) const
+{
+    blst.clear();
+    blst.reserve(lst.size());
+    ntags.clear();
+    ntags.reserve(lst.size());
+    for (std::list<Cluster*>::const_iterator cli = lst.begin(), End = lst.end();
+         cli != End;
+         ++cli)
+    {
+        blst.push_back((*cli)->box());
+        ntags.push_back((*cli)->numTag());
+    }
+}
+
 void
 ClusterList::chop (Real eff)
 {
@@ -593,4 +610,216 @@ ClusterList::intersect (const BoxDomain& dom)
     }
 }
 
+namespace {
+
+struct ClusterBox
+{
+    Box  box;
+    Long ntags;
+};
+
+constexpr int ClusterBoxSize = 2*AMREX_SPACEDIM+1;
+
+void
+packClusters (const Vector<ClusterBox>& cl, Vector<Long>& buf)
+{
+    buf.clear();
+    buf.reserve(cl.size()*ClusterBoxSize);
+    for (const auto& c : cl) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            buf.push_back(c.box.smallEnd(idim));
+            buf.push_back(c.box.bigEnd(idim));
+        }
+        buf.push_back(c.ntags);
+    }
+}
+
+void
+unpackClusters (const Vector<Long>& buf, Vector<ClusterBox>& cl)
+{
+    for (int i = 0; i < buf.size(); i += ClusterBoxSize) {
+        IntVect lo, hi;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            lo[idim] = static_cast<int>(buf[i+2*idim]);
+            hi[idim] = static_cast<int>(buf[i+2*idim+1]);
+        }
+        cl.push_back(ClusterBox{Box(lo,hi), buf[i+2*AMREX_SPACEDIM]});
+    }
+}
+
+//
+// Merge clusters that touch if their bounding box is efficient enough and
+// inside the proper nesting domain.  Sweep along the first direction.
+//
+void
+mergeClusters (Vector<ClusterBox>& cl, Real eff, const BoxArray& domba)
+{
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+
+        std::sort(cl.begin(), cl.end(),
+                  [] (const ClusterBox& a, const ClusterBox& b)
+                  { return a.box.smallEnd(0) < b.box.smallEnd(0); });
+
+        const int n = cl.size();
+        Vector<char> dead(n,0);
+        for (int i = 0; i < n; ++i)
+        {
+            if (dead[i]) continue;
+            for (int j = i+1; j < n; ++j)
+            {
+                if (cl[j].box.smallEnd(0) > cl[i].box.bigEnd(0)+1) break;
+                if (dead[j] || !amrex::grow(cl[i].box,1).intersects(cl[j].box)) continue;
+
+                const Box bb = amrex::minBox(cl[i].box, cl[j].box);
+                // The tags of different clusters are disjoint, so this is
+                // a lower bound of the number of tags in bb.
+                const Long nt = cl[i].ntags + cl[j].ntags;
+                const bool assume_disjoint_ba = true;
+                if (nt >= eff*bb.d_numPts() && domba.contains(bb,assume_disjoint_ba))
+                {
+                    cl[i].box = bb;
+                    cl[i].ntags = nt;
+                    dead[j] = 1;
+                    merged = true;
+                }
+            }
+        }
+
+        if (merged) {
+            int m = 0;
+            for (int i = 0; i < n; ++i) {
+                if (!dead[i]) cl[m++] = cl[i];
+            }
+            cl.resize(m);
+        }
+    }
+}
+
+}
+
+BoxList
+ParallelCluster (Vector<IntVect>& tags, Real eff, bool use_new_chop, const BoxDomain& dom)
+{
+    BL_PROFILE("ParallelCluster()");
+
+    const BoxArray domba(dom.boxList());
+
+    //
+    // Cluster the local tags.
+    //
+    Vector<ClusterBox> cl;
+    if (!tags.empty())
+    {
+        ClusterList clist(tags.data(), tags.size());
+        if (use_new_chop) {
+            clist.new_chop(eff);
+        } else {
+            clist.chop(eff);
+        }
+        clist.intersect(dom);
+
+        BoxList bl;
+        Vector<Long> ntags;
+        clist.boxList(bl, ntags);
+        int i = 0;
+        for (const Box& b : bl) {
+            cl.push_back(ClusterBox{b, ntags[i++]});
+        }
+    }
+
+    const int root = 0;
+    const int myproc = ParallelDescriptor::MyProc();
+
+#ifdef BL_USE_MPI
+    //
+    // Merge the clusters in a binary tree rooted at process 0.
+    //
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int seqno = ParallelDescriptor::SeqNum();
+    Vector<Long> buf;
+    for (int step = 1; step < nprocs; step *= 2)
+    {
+        if (myproc % (2*step) == step)
+        {
+            packClusters(cl, buf);
+            Long n = buf.size();
+            ParallelDescriptor::Send(&n, 1, myproc-step, seqno);
+            if (n > 0) {
+                ParallelDescriptor::Send(buf.data(), n, myproc-step, seqno);
+            }
+            cl.clear();
+            break;
+        }
+        else if (myproc % (2*step) == 0 && myproc+step < nprocs)
+        {
+            Long n = 0;
+            ParallelDescriptor::Recv(&n, 1, myproc+step, seqno);
+            if (n > 0) {
+                buf.resize(n);
+                ParallelDescriptor::Recv(buf.data(), n, myproc+step, seqno);
+                unpackClusters(buf, cl);
+                mergeClusters(cl, eff, domba);
+            }
+        }
+    }
+#endif
+
+    //
+    // Make the boxes disjoint on the root, and broadcast them.
+    //
+    Vector<int> boxbuf;
+    if (myproc == root && !cl.empty())
+    {
+        BoxList allbl;
+        for (const auto& c : cl) {
+            allbl.push_back(c.box);
+        }
+        const BoxArray allba(allbl);
+
+        std::vector<std::pair<int,Box> > isects;
+        for (int i = 0, N = allba.size(); i < N; ++i)
+        {
+            BoxList pieces(allba[i]);
+            allba.intersections(allba[i], isects);
+            for (const auto& is : isects)
+            {
+                if (is.first >= i) continue;
+                BoxList diff;
+                for (const Box& b : pieces) {
+                    diff.join(amrex::boxDiff(b, allba[is.first]));
+                }
+                pieces = std::move(diff);
+            }
+            for (const Box& b : pieces) {
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    boxbuf.push_back(b.smallEnd(idim));
+                    boxbuf.push_back(b.bigEnd(idim));
+                }
+            }
+        }
+    }
+
+    int n = boxbuf.size();
+    ParallelDescriptor::Bcast(&n, 1, root);
+    boxbuf.resize(n);
+    if (n > 0) {
+        ParallelDescriptor::Bcast(boxbuf.data(), n, root);
+    }
+
+    BoxList r;
+    r.reserve(n/(2*AMREX_SPACEDIM));
+    for (int i = 0; i < n; i += 2*AMREX_SPACEDIM) {
+        IntVect lo, hi;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            lo[idim] = boxbuf[i+2*idim];
+            hi[idim] = boxbuf[i+2*idim+1];
+        }
+        r.push_back(Box(lo,hi));
+    }
+    return r;
+}
+
 }
@@ -77,6 +77,8 @@ FluxRegister::define (const BoxArray&            fine_boxes,
     grids = fine_boxes;
     grids.coarsen(ratio);
 
+    m_reflux_plan.reset();
+
     for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
     {
         const Orientation lo_face(dir,Orientation::low);
@@ -95,6 +97,7 @@ void
 FluxRegister::clear ()
 {
     BndryRegister::clear();
+    m_reflux_plan.reset();
 }
 
 FluxRegister::~FluxRegister () {}
@@ -177,9 +180,6 @@ FluxRegister::CrseInit (const MultiFab& mflx,
     BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= ncomp);
 
-    const Orientation face_lo(dir,Orientation::low);
-    const Orientation face_hi(dir,Orientation::high);
- 
     MultiFab mf(mflx.boxArray(),mflx.DistributionMap(),numcomp,0,
                 MFInfo(), mflx.Factory());
 
@@ -198,6 +198,55 @@ FluxRegister::CrseInit (const MultiFab& mflx,
         });
     }
 
+    CrseInit_doit(mf,dir,destcomp,numcomp,op);
+}
+
+void
+FluxRegister::CrseInit (const MultiFab& mflx,
+                        int             dir,
+                        int             srccomp,
+                        int             destcomp,
+                        int             numcomp,
+                        Real            mult,
+                        FrOp            op)
+{
+    BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx.nComp());
+    BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= ncomp);
+
+    if (mult == 1.0)
+    {
+        // No scaling needed: the registers are filled directly from mflx.
+        MultiFab mf(mflx, amrex::make_alias, srccomp, numcomp);
+        CrseInit_doit(mf,dir,destcomp,numcomp,op);
+        return;
+    }
+
+    MultiFab mf(mflx.boxArray(),mflx.DistributionMap(),numcomp,0,
+                MFInfo(), mflx.Factory());
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif    
+    for (MFIter mfi(mflx,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+	const Box& bx = mfi.tilebox();
+        auto       dfab =   mf.array(mfi);
+        auto const sfab = mflx.const_array(mfi);
+        AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, numcomp, i, j, k, n,
+        {
+            dfab(i,j,k,n) = sfab(i,j,k,n+srccomp)*mult;
+        });
+    }
+
+    CrseInit_doit(mf,dir,destcomp,numcomp,op);
+}
+
+void
+FluxRegister::CrseInit_doit (const MultiFab& mf, int dir, int destcomp, int numcomp, FrOp op)
+{
+    const Orientation face_lo(dir,Orientation::low);
+    const Orientation face_hi(dir,Orientation::high);
+
     for (int pass = 0; pass < 2; pass++)
     {
         const Orientation face = ((pass == 0) ? face_lo : face_hi);
@@ -231,26 +280,6 @@ FluxRegister::CrseInit (const MultiFab& mflx,
     }
 }
 
-void
-FluxRegister::CrseInit (const MultiFab& mflx,
-                        int             dir,
-                        int             srccomp,
-                        int             destcomp,
-                        int             numcomp,
-                        Real            mult,
-                        FrOp            op)
-{
-    BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx.nComp());
-    BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= ncomp);
-
-    MultiFab area(mflx.boxArray(), mflx.DistributionMap(), 1, 0,
-                  MFInfo(), mflx.Factory());
-
-    area.setVal(1, 0, 1, 0);
-
-    CrseInit(mflx,area,dir,srccomp,destcomp,numcomp,mult,op);
-}
-
 void
 FluxRegister::CrseAdd (const MultiFab& mflx,
                        const MultiFab& area,
@@ -349,6 +378,25 @@ FluxRegister::FineAdd (const MultiFab& mflx,
     }
 }
 
+void
+FluxRegister::FineAdd (Array<MultiFab const*,AMREX_SPACEDIM> const& mflx,
+                       int             srccomp,
+                       int             destcomp,
+                       int             numcomp,
+                       Real            mult)
+{
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(*mflx[0]); mfi.isValid(); ++mfi)
+    {
+        const int k = mfi.index();
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            FineAdd((*mflx[dir])[mfi],dir,k,srccomp,destcomp,numcomp,mult,RunOn::Gpu);
+        }
+    }
+}
+
 void
 FluxRegister::FineAdd (const FArrayBox& flux,
                        int              dir,
@@ -481,11 +529,11 @@ FluxRegister::Reflux (MultiFab&       mf,
 		      int             nc,
 		      const Geometry& geom)
 {
-    for (OrientationIter fi; fi; ++fi)
-    {
-	const Orientation& face = fi();
-        Reflux(mf, volume, face, scale, scomp, dcomp, nc, geom);
+    Vector<Orientation> faces;
+    for (OrientationIter fi; fi; ++fi) {
+        faces.push_back(fi());
     }
+    Reflux(mf, volume, faces, scale, scomp, dcomp, nc, geom);
 }
 
 void
@@ -498,12 +546,9 @@ FluxRegister::Reflux (MultiFab&       mf,
 		      int             nc,
 		      const Geometry& geom)
 {
-    for (int s = 0; s < 2; ++s)
-    {
-        Orientation::Side side = (s==0) ? Orientation::low : Orientation::high;
-	Orientation face(dir, side);
-        Reflux(mf, volume, face, scale, scomp, dcomp, nc, geom);
-    }
+    Vector<Orientation> faces{Orientation(dir,Orientation::low),
+                              Orientation(dir,Orientation::high)};
+    Reflux(mf, volume, faces, scale, scomp, dcomp, nc, geom);
 }
 
 void
@@ -547,29 +592,139 @@ void
 FluxRegister::Reflux (MultiFab& mf, const MultiFab& volume, Orientation face,
                       Real scale, int scomp, int dcomp, int nc, const Geometry& geom)
 {
-    BL_PROFILE("FluxRegister::Reflux()");
+    Vector<Orientation> faces{face};
+    Reflux(mf, volume, faces, scale, scomp, dcomp, nc, geom);
+}
+
+const FluxRegister::RefluxPlan&
+FluxRegister::getRefluxPlan (const MultiFab& mf, const Periodicity& period)
+{
+    if (m_reflux_plan &&
+        m_reflux_plan->crse_ba == mf.boxArray() &&
+        m_reflux_plan->crse_dm == mf.DistributionMap() &&
+        m_reflux_plan->period  == period)
+    {
+        return *m_reflux_plan;
+    }
+
+    BL_PROFILE("FluxRegister::getRefluxPlan()");
+
+    m_reflux_plan.reset(new RefluxPlan);
+    RefluxPlan& plan = *m_reflux_plan;
+    plan.crse_ba = mf.boxArray();
+    plan.crse_dm = mf.DistributionMap();
+    plan.period  = period;
+    plan.tags.resize(mf.local_size());
+
+    const BoxArray& cba = mf.boxArray();
+    const DistributionMapping& cdm = mf.DistributionMap();
+    const std::vector<IntVect>& pshifts = period.shiftIntVect();
+    const int myproc = ParallelDescriptor::MyProc();
 
-    int idir = face.coordDir();
+    std::vector< std::pair<int,Box> > isects;
 
-    MultiFab flux(amrex::convert(mf.boxArray(), IntVect::TheDimensionVector(idir)),
-                  mf.DistributionMap(), nc, 0, MFInfo(), mf.Factory());
-    flux.setVal(0.0);
+    for (OrientationIter fi; fi; ++fi)
+    {
+        const Orientation face = fi();
+        const BoxArray& rba = bndry[face].boxArray();
+        const IndexType typ = rba.ixType();
 
-    bndry[face].copyTo(flux, 0, scomp, 0, nc, geom.periodicity());
+        BoxList bl(typ);
+        Vector<int> pmap;
+
+        for (int j = 0, N = cba.size(); j < N; ++j)
+        {
+            const Box& cbx = amrex::convert(cba[j], typ);
+
+            // Register boxes of the same face do not overlap, except for
+            // periodic images.  Overlaps are removed so that every coarse
+            // face receives a single value, as with ParallelCopy.
+            BoxList blj(typ);
+            for (const auto& iv : pshifts)
+            {
+                rba.intersections(cbx+iv, isects);
+                for (const auto& is : isects)
+                {
+                    BoxList bnew(is.second-iv);
+                    for (const Box& b : blj) {
+                        BoxList tmp(typ);
+                        for (const Box& bn : bnew) {
+                            tmp.join(amrex::boxDiff(bn,b));
+                        }
+                        bnew = std::move(tmp);
+                    }
+                    blj.join(bnew);
+                }
+            }
+
+            for (const Box& b : blj)
+            {
+                if (cdm[j] == myproc) {
+                    plan.tags[mf.localindex(j)].push_back(std::make_pair(face, int(pmap.size())));
+                }
+                bl.push_back(b);
+                pmap.push_back(cdm[j]);
+            }
+        }
+
+        if (!bl.isEmpty()) {
+            plan.ba[face].define(std::move(bl));
+            plan.dm[face].define(std::move(pmap));
+        }
+    }
+
+    return plan;
+}
+
+void
+FluxRegister::Reflux (MultiFab& mf, const MultiFab& volume, const Vector<Orientation>& faces,
+                      Real scale, int scomp, int dcomp, int nc, const Geometry& geom)
+{
+    BL_PROFILE("FluxRegister::Reflux()");
+
+    const RefluxPlan& plan = getRefluxPlan(mf, geom.periodicity());
+
+    // The register data of all faces are first copied to the coarse grids.
+    Array<std::unique_ptr<MultiFab>,2*AMREX_SPACEDIM> flux;
+    for (const auto& face : faces)
+    {
+        if (!plan.ba[face].empty()) {
+            flux[face].reset(new MultiFab(plan.ba[face], plan.dm[face], nc, 0));
+            bndry[face].copyTo(*flux[face], 0, scomp, 0, nc, geom.periodicity());
+        }
+    }
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-    for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
     {
-        const Box& bx = mfi.tilebox();
+        const Box& vbx = mfi.validbox();
         Array4<Real> const& sfab = mf.array(mfi);
-        Array4<Real const> const& ffab = flux.const_array(mfi);
         Array4<Real const> const& vfab = volume.const_array(mfi);
-        AMREX_LAUNCH_HOST_DEVICE_LAMBDA (bx, tbx,
+
+        for (const auto& tag : plan.tags[mfi.LocalIndex()])
         {
-            fluxreg_reflux(tbx, sfab, dcomp, ffab, vfab, nc, scale, face);
-        });
+            const Orientation face = tag.first;
+            if (!flux[face]) continue;
+
+            Array4<Real const> const& ffab = flux[face]->const_array(tag.second);
+
+            // Cells next to the faces of the register
+            const Box& fbx = flux[face]->box(tag.second);
+            Box bx(fbx.smallEnd(), fbx.bigEnd());
+            if (face.isLow()) {
+                bx.shift(face.coordDir(), -1);
+            }
+            bx &= vbx;
+
+            if (bx.ok()) {
+                AMREX_LAUNCH_HOST_DEVICE_LAMBDA (bx, tbx,
+                {
+                    fluxreg_reflux(tbx, sfab, dcomp, ffab, vfab, nc, scale, face);
+                });
+            }
+        }
     }
 }
 
@@ -6,23 +6,12 @@
 #include <AMReX_Interpolater.H>
 #include <AMReX_Interp_C.H>
 
-#ifndef BL_NO_FORT
-#include <AMReX_INTERP_F.H>
-#endif
-
 namespace amrex {
 
 //
-// PCInterp, NodeBilinear, FaceLinear, and CellConservativeLinear are supported for all dimensions
-// on cpu and gpu.
-//
-// CellConsertiveProtected only works in 2D and 3D on cpu.
-//
-// CellBilinear works in 1D, 2D and 3D on cpu.
+// All interpolaters are supported for all dimensions on cpu and gpu.
 //
-// CellQuadratic only works in 2D on cpu.
-//
-// CellConservativeQuartic only works with ref ratio of 2 on cpu
+// CellConservativeQuartic only works with ref ratio of 2.
 //
 
 //
@@ -33,16 +22,44 @@ NodeBilinear              node_bilinear_interp;
 FaceLinear                face_linear_interp;
 CellConservativeLinear    lincc_interp;
 CellConservativeLinear    cell_cons_interp(0);
-
-#ifndef BL_NO_FORT
 CellBilinear              cell_bilinear_interp;
 CellQuadratic             quadratic_interp;
 CellConservativeProtected protected_interp;
 CellConservativeQuartic   quartic_interp;
-#endif
 
 Interpolater::~Interpolater () {}
 
+void
+Interpolater::BatchInterp (Vector<InterpPatch> const& patches,
+                           int              crse_comp,
+                           int              fine_comp,
+                           int              ncomp,
+                           const IntVect&   ratio,
+                           const Geometry&  crse_geom,
+                           const Geometry&  fine_geom,
+                           int              actual_comp,
+                           int              actual_state,
+                           RunOn            runon)
+{
+    BL_PROFILE("Interpolater::BatchInterp()");
+
+    const int npatches = patches.size();
+    if (npatches == 0) return;
+
+    const bool cc = patches[0].fine_region.ixType().cellCentered();
+    amrex::ignore_unused(cc);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (cc && Gpu::notInLaunchRegion())
+#endif
+    for (int ip = 0; ip < npatches; ++ip)
+    {
+        InterpPatch const& p = patches[ip];
+        interp(*p.crse, crse_comp, *p.fine, fine_comp, ncomp, p.fine_region, ratio,
+               crse_geom, fine_geom, p.bcr, actual_comp, actual_state, runon);
+    }
+}
+
 InterpolaterBoxCoarsener
 Interpolater::BoxCoarsener (const IntVect& ratio)
 {
@@ -213,7 +230,6 @@ FaceLinear::interp (const FArrayBox&  crse,
 
 FaceLinear::~FaceLinear () {}
 
-#ifndef BL_NO_FORT
 CellBilinear::~CellBilinear () {}
 
 Box
@@ -257,44 +273,22 @@ CellBilinear::interp (const FArrayBox&  crse,
                       const Geometry& /*crse_geom*/,
                       const Geometry& /*fine_geom*/,
                       Vector<BCRec> const& /*bcr*/,
-                      int               actual_comp,
-                      int               actual_state,
+                      int               /*actual_comp*/,
+                      int               /*actual_state*/,
                       RunOn             runon)
 {
     BL_PROFILE("CellBilinear::interp()");
-    //
-    // Set up to call FORTRAN.
-    //
-    const int* clo = crse.box().loVect();
-    const int* chi = crse.box().hiVect();
-    const int* flo = fine.loVect();
-    const int* fhi = fine.hiVect();
-    const int* lo  = fine_region.loVect();
-    const int* hi  = fine_region.hiVect();
-    int num_slope  = AMREX_D_TERM(2,*2,*2)-1;
-    int len0       = crse.box().length(0);
-    int slp_len    = num_slope*len0;
 
-    Vector<Real> slope(slp_len);
-
-    int strp_len = len0*ratio[0];
-
-    Vector<Real> strip(strp_len);
-
-    int strip_lo = ratio[0] * clo[0];
-    int strip_hi = ratio[0] * chi[0];
+    AMREX_ASSERT(fine.box().contains(fine_region));
 
-    const Real* cdat  = crse.dataPtr(crse_comp);
-    Real*       fdat  = fine.dataPtr(fine_comp);
-    const int* ratioV = ratio.getVect();
+    Array4<Real const> const& crsearr = crse.const_array();
+    Array4<Real> const& finearr = fine.array();
 
-    amrex_cbinterp (cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),AMREX_ARLIM(clo),AMREX_ARLIM(chi),
-                   fdat,AMREX_ARLIM(flo),AMREX_ARLIM(fhi),AMREX_ARLIM(lo),AMREX_ARLIM(hi),
-                   AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),&ncomp,
-                   slope.dataPtr(),&num_slope,strip.dataPtr(),&strip_lo,&strip_hi,
-                   &actual_comp,&actual_state);
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, fine_region, tbx,
+    {
+        amrex::cellbilin_interp(tbx, finearr, fine_comp, ncomp, crsearr, crse_comp, ratio);
+    });
 }
-#endif
 
 Vector<int>
 Interpolater::GetBCArray (const Vector<BCRec>& bcr)
@@ -432,7 +426,6 @@ CellConservativeLinear::interp (const FArrayBox& crse,
     }
 }
 
-#ifndef BL_NO_FORT
 CellQuadratic::CellQuadratic (bool limit)
 {
     do_limited_slope = limit;
@@ -469,97 +462,53 @@ CellQuadratic::interp (const FArrayBox& crse,
                        const Geometry&  crse_geom,
                        const Geometry&  fine_geom,
                        Vector<BCRec> const&  bcr,
-                       int              actual_comp,
-                       int              actual_state,
+                       int              /*actual_comp*/,
+                       int              /*actual_state*/,
                        RunOn            runon)
 {
     BL_PROFILE("CellQuadratic::interp()");
     BL_ASSERT(bcr.size() >= ncomp);
+
+    bool run_on_gpu = (runon == RunOn::Gpu && Gpu::inLaunchRegion());
+
     //
     // Make box which is intersection of fine_region and domain of fine.
     //
-    Box target_fine_region = fine_region & fine.box();
+    const Box& target_fine_region = fine_region & fine.box();
 
-    Box crse_bx(amrex::coarsen(target_fine_region,ratio));
-    Box fslope_bx(amrex::refine(crse_bx,ratio));
-    Box cslope_bx(crse_bx);
-    cslope_bx.grow(1);
-    BL_ASSERT(crse.box().contains(cslope_bx));
-    //
-    // Alloc temp space for coarse grid slopes: here we use 5
-    // instead of AMREX_SPACEDIM because of the x^2, y^2 and xy terms
-    //
-    long t_long = cslope_bx.numPts();
-    BL_ASSERT(t_long < INT_MAX);
-    int c_len = int(t_long);
+    const Box& crse_bx = amrex::coarsen(target_fine_region,ratio);
+    BL_ASSERT(crse.box().contains(amrex::grow(crse_bx,1)));
 
-    Vector<Real> cslope(5*c_len);
+    Array4<Real const> const& crsearr = crse.const_array();
+    Array4<Real> const& finearr = fine.array();
 
-    int loslp = cslope_bx.index(crse_bx.smallEnd());
-    int hislp = cslope_bx.index(crse_bx.bigEnd());
+    AsyncArray<BCRec> async_bcr(bcr.data(), (run_on_gpu) ? ncomp : 0);
+    BCRec const* bcrp = (run_on_gpu) ? async_bcr.data() : bcr.data();
 
-    t_long = cslope_bx.numPts();
-    BL_ASSERT(t_long < INT_MAX);
-    int cslope_vol = int(t_long);
-    int clo        = 1 - loslp;
-    int chi        = clo + cslope_vol - 1;
-    c_len          = hislp - loslp + 1;
-    //
-    // Alloc temp space for one strip of fine grid slopes: here we use 5
-    // instead of AMREX_SPACEDIM because of the x^2, y^2 and xy terms.
-    //
-    int dir;
-    int f_len = fslope_bx.longside(dir);
+    // first and second derivatives of every component, cf. cellquadratic_slopes
+    const int nslope = AMREX_D_PICK(2,5,9);
+    FArrayBox slopefab(crse_bx, nslope*ncomp);
+    Elixir slopeeli;
+    if (run_on_gpu) slopeeli = slopefab.elixir();
+    Array4<Real> const& slopearr = slopefab.array();
+    Array4<Real const> const& cslopearr = slopefab.const_array();
 
-    Vector<Real> strip((5+2)*f_len);
+    const Vector<Real>& vec_voff = amrex::ccinterp_compute_voff(crse_bx, ratio, crse_geom, fine_geom);
 
-    Real* fstrip = strip.dataPtr();
-    Real* foff   = fstrip + f_len;
-    Real* fslope = foff + f_len;
-    //
-    // Get coarse and fine edge-centered volume coordinates.
-    //
-    Vector<Real> fvc[AMREX_SPACEDIM];
-    Vector<Real> cvc[AMREX_SPACEDIM];
-    for (dir = 0; dir < AMREX_SPACEDIM; dir++)
+    AsyncArray<Real> async_voff(vec_voff.data(), (run_on_gpu) ? vec_voff.size() : 0);
+    Real const* voff = (run_on_gpu) ? async_voff.data() : vec_voff.data();
+
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, crse_bx, tbx,
     {
-        fine_geom.GetEdgeVolCoord(fvc[dir],target_fine_region,dir);
-        crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
-    }
-    //
-    // Alloc tmp space for slope calc and to allow for vectorization.
-    //
-    Real* fdat        = fine.dataPtr(fine_comp);
-    const Real* cdat  = crse.dataPtr(crse_comp);
-    const int* flo    = fine.loVect();
-    const int* fhi    = fine.hiVect();
-    const int* fblo   = target_fine_region.loVect();
-    const int* fbhi   = target_fine_region.hiVect();
-    const int* cblo   = crse_bx.loVect();
-    const int* cbhi   = crse_bx.hiVect();
-    const int* fslo   = fslope_bx.loVect();
-    const int* fshi   = fslope_bx.hiVect();
-    int slope_flag    = (do_limited_slope ? 1 : 0);
-    Vector<int> bc     = GetBCArray(bcr);
-    const int* ratioV = ratio.getVect();
-
-#if (AMREX_SPACEDIM > 1)
-
-    amrex_cqinterp (fdat,AMREX_ARLIM(flo),AMREX_ARLIM(fhi),
-                   AMREX_ARLIM(fblo), AMREX_ARLIM(fbhi),
-                   &ncomp,AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
-                   cdat,&clo,&chi,
-                   AMREX_ARLIM(cblo), AMREX_ARLIM(cbhi),
-                   fslo,fshi,
-                   cslope.dataPtr(),&c_len,fslope,fstrip,&f_len,foff,
-                   bc.dataPtr(), &slope_flag,
-                   AMREX_D_DECL(fvc[0].dataPtr(),fvc[1].dataPtr(),fvc[2].dataPtr()),
-                   AMREX_D_DECL(cvc[0].dataPtr(),cvc[1].dataPtr(),cvc[2].dataPtr()),
-                   &actual_comp,&actual_state);
-
-#endif /*(AMREX_SPACEDIM > 1)*/
+        amrex::cellquadratic_slopes(tbx, slopearr, crsearr, crse_comp, ncomp, bcrp);
+    });
+
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, target_fine_region, tbx,
+    {
+        amrex::cellquadratic_interp(tbx, finearr, fine_comp, ncomp, cslopearr, crsearr, crse_comp,
+                                    voff, ratio);
+    });
 }
-#endif
 
 
 PCInterp::~PCInterp () {}
@@ -604,7 +553,6 @@ PCInterp::interp (const FArrayBox& crse,
     });
 }
 
-#ifndef BL_NO_FORT
 CellConservativeProtected::CellConservativeProtected () {}
 
 CellConservativeProtected::~CellConservativeProtected () {}
@@ -690,8 +638,8 @@ CellConservativeProtected::interp (const FArrayBox& crse,
 }
 
 void
-CellConservativeProtected::protect (const FArrayBox& crse,
-                                    int              crse_comp,
+CellConservativeProtected::protect (const FArrayBox& /*crse*/,
+                                    int              /*crse_comp*/,
                                     FArrayBox&       fine,
                                     int              fine_comp,
                                     FArrayBox&       fine_state,
@@ -699,96 +647,62 @@ CellConservativeProtected::protect (const FArrayBox& crse,
                                     int              ncomp,
                                     const Box&       fine_region,
                                     const IntVect&   ratio,
-                                    const Geometry&  crse_geom,
+                                    const Geometry&  /*crse_geom*/,
                                     const Geometry&  fine_geom,
                                     Vector<BCRec>&   bcr,
                                     RunOn            runon)
 {
     BL_PROFILE("CellConservativeProtected::protect()");
     BL_ASSERT(bcr.size() >= ncomp);
+    amrex::ignore_unused(fine_geom,bcr);
 
     //
     // Make box which is intersection of fine_region and domain of fine.
     //
-    Box target_fine_region = fine_region & fine.box();
-
-    //
-    // crse_bx is coarsening of target_fine_region, grown by 1.
-    //
-    Box crse_bx = CoarseBox(target_fine_region,ratio);
+    const Box& target_fine_region = fine_region & fine.box();
 
     //
     // cs_bx is coarsening of target_fine_region.
     //
-    Box cs_bx(crse_bx);
-    cs_bx.grow(-1);
+    const Box& cs_bx = amrex::coarsen(target_fine_region,ratio);
+
+    Array4<Real> const& finearr = fine.array();
+    Array4<Real const> const& statearr = fine_state.const_array();
+
+#if (AMREX_SPACEDIM == 3)
+    // The 3D kernel uses the number of fine cells, not their volume.
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(fine_geom.IsCartesian(),
+                                     "CellConservativeProtected: 3D requires Cartesian coordinates");
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, cs_bx, tbx,
+    {
+        amrex::ccprotect_interp(tbx, finearr, fine_comp, statearr, state_comp, ncomp, ratio);
+    });
+#else
+    bool run_on_gpu = (runon == RunOn::Gpu && Gpu::inLaunchRegion());
 
     //
-    // Get coarse and fine edge-centered volume coordinates.
+    // Fine edge-centered volume coordinates of all the fine cells covered by cs_bx.
     //
-    int dir;
-    Vector<Real> fvc[AMREX_SPACEDIM];
-    Vector<Real> cvc[AMREX_SPACEDIM];
-    for (dir = 0; dir < AMREX_SPACEDIM; dir++)
+    const Box& fvbx = amrex::refine(cs_bx,ratio) & fine.box();
+    Vector<Real> vec_fvc;
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
     {
-        fine_geom.GetEdgeVolCoord(fvc[dir],target_fine_region,dir);
-        crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
+        Vector<Real> fvc;
+        fine_geom.GetEdgeVolCoord(fvc,fvbx,dir);
+        vec_fvc.insert(vec_fvc.end(), fvc.begin(), fvc.end());
     }
 
-#if (AMREX_SPACEDIM == 2)
-    const int* cvcblo = crse_bx.loVect();
-    const int* fvcblo = target_fine_region.loVect();
-
-    int cvcbhi[AMREX_SPACEDIM];
-    int fvcbhi[AMREX_SPACEDIM];
+    AsyncArray<Real> async_fvc(vec_fvc.data(), (run_on_gpu) ? vec_fvc.size() : 0);
+    Real const* fvc = (run_on_gpu) ? async_fvc.data() : vec_fvc.data();
 
-    for (dir=0; dir<AMREX_SPACEDIM; dir++)
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, cs_bx, tbx,
     {
-        cvcbhi[dir] = cvcblo[dir] + cvc[dir].size() - 1;
-        fvcbhi[dir] = fvcblo[dir] + fvc[dir].size() - 1;
-    }
-#endif
-
-    Real* fdat       = fine.dataPtr(fine_comp);
-    Real* state_dat  = fine_state.dataPtr(state_comp);
-    const Real* cdat = crse.dataPtr(crse_comp);
-
-    const int* flo    = fine.loVect();
-    const int* fhi    = fine.hiVect();
-    const int* slo    = fine_state.loVect();
-    const int* shi    = fine_state.hiVect();
-    const int* clo    = crse.loVect();
-    const int* chi    = crse.hiVect();
-    const int* fblo   = target_fine_region.loVect();
-    const int* fbhi   = target_fine_region.hiVect();
-    const int* csbhi  = cs_bx.hiVect();
-    const int* csblo  = cs_bx.loVect();
-
-    Vector<int> bc     = GetBCArray(bcr);
-    const int* ratioV = ratio.getVect();
-
-#if (AMREX_SPACEDIM > 1)
-
-    amrex_protect_interp (fdat,AMREX_ARLIM(flo),AMREX_ARLIM(fhi),
-                         fblo, fbhi,
-                         cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),
-                         csblo, csbhi,
-#if (AMREX_SPACEDIM == 2)
-                         fvc[0].dataPtr(),fvc[1].dataPtr(),
-                         AMREX_ARLIM(fvcblo), AMREX_ARLIM(fvcbhi),
-                         cvc[0].dataPtr(),cvc[1].dataPtr(),
-                         AMREX_ARLIM(cvcblo), AMREX_ARLIM(cvcbhi),
+        amrex::ccprotect_interp(tbx, finearr, fine_comp, statearr, state_comp, ncomp, ratio,
+                                fvc, fvbx);
+    });
 #endif
-                         state_dat, AMREX_ARLIM(slo), AMREX_ARLIM(shi),
-                         &ncomp,AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
-                         bc.dataPtr());
-
-#endif /*(AMREX_SPACEDIM > 1)*/
-
 }
-#endif
 
-#ifndef BL_NO_FORT
 CellConservativeQuartic::~CellConservativeQuartic () {}
 
 Box
@@ -820,74 +734,79 @@ CellConservativeQuartic::interp (const FArrayBox&  crse,
 				 const Geometry&   /* crse_geom */,
 				 const Geometry&   /* fine_geom */,
 				 Vector<BCRec> const&   bcr,
-				 int               actual_comp,
-				 int               actual_state,
+				 int               /*actual_comp*/,
+				 int               /*actual_state*/,
                                  RunOn             runon)
 {
     BL_PROFILE("CellConservativeQuartic::interp()");
     BL_ASSERT(bcr.size() >= ncomp);
-    BL_ASSERT(ratio[0]==2);
-#if (AMREX_SPACEDIM >= 2)
-    BL_ASSERT(ratio[0] == ratio[1]);
-#endif
-#if (AMREX_SPACEDIM == 3)
-    BL_ASSERT(ratio[1] == ratio[2]);
-#endif
+    amrex::ignore_unused(bcr);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ratio == 2,
+                                     "CellConservativeQuartic: only refinement ratio 2 is supported");
 
     //
     // Make box which is intersection of fine_region and domain of fine.
     //
-    Box target_fine_region = fine_region & fine.box();
+    const Box& target_fine_region = fine_region & fine.box();
+
+    Array4<Real const> const& crsearr = crse.const_array();
+    Array4<Real> const& finearr = fine.array();
+
+#if (AMREX_SPACEDIM == 1)
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, target_fine_region, tbx,
+    {
+        amrex::quartinterp_x(tbx, finearr, fine_comp, ncomp, crsearr, crse_comp);
+    });
+#else
+    bool run_on_gpu = (runon == RunOn::Gpu && Gpu::inLaunchRegion());
+
     //
     // crse_bx is coarsening of target_fine_region, grown by 2.
     //
-    Box crse_bx = CoarseBox(target_fine_region,ratio);
-
-    Box crse_bx2(crse_bx);
-    crse_bx2.grow(-2);
-    Box fine_bx2 = amrex::refine(crse_bx2,ratio);
-
-    Real* fdat       = fine.dataPtr(fine_comp);
-    const Real* cdat = crse.dataPtr(crse_comp);
-
-    const int* flo    = fine.loVect();
-    const int* fhi    = fine.hiVect();
-    const int* clo    = crse.loVect();
-    const int* chi    = crse.hiVect();
-    const int* fblo   = target_fine_region.loVect();
-    const int* fbhi   = target_fine_region.hiVect();
-    const int* cblo   = crse_bx.loVect();
-    const int* cbhi   = crse_bx.hiVect();
-    const int* cb2lo  = crse_bx2.loVect();
-    const int* cb2hi  = crse_bx2.hiVect();
-    const int* fb2lo  = fine_bx2.loVect();
-    const int* fb2hi  = fine_bx2.hiVect();
-
-    Vector<int> bc     = GetBCArray(bcr);
-    const int* ratioV = ratio.getVect();
-
-    int ltmp = fb2hi[0]-fb2lo[0]+1;
-    Vector<Real> ftmp(ltmp);
+    const Box& crse_bx = CoarseBox(target_fine_region,ratio);
 
-#if (AMREX_SPACEDIM >= 2)
-    ltmp = (cbhi[0]-cblo[0]+1)*ratio[1];
-    Vector<Real> ctmp(ltmp);
-#endif
+    //
+    // The interpolation is done one direction at a time, starting with the
+    // last one. tmp_bx is refined in all but the first direction.
+    //
+    Box tmp_bx = target_fine_region;
+    tmp_bx.setRange(0, crse_bx.smallEnd(0), crse_bx.length(0));
+    FArrayBox tmpfab(tmp_bx, ncomp);
+    Elixir tmpeli;
+    if (run_on_gpu) tmpeli = tmpfab.elixir();
+    Array4<Real> const& tmparr = tmpfab.array();
+    Array4<Real const> const& ctmparr = tmpfab.const_array();
 
-#if (AMREX_SPACEDIM == 3)
-    ltmp = (cbhi[0]-cblo[0]+1)*(cbhi[1]-cblo[1]+1)*ratio[2];
-    Vector<Real> ctmp2(ltmp);
+#if (AMREX_SPACEDIM == 2)
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, tmp_bx, tbx,
+    {
+        amrex::quartinterp_y(tbx, tmparr, 0, ncomp, crsearr, crse_comp);
+    });
+#else
+    Box tmp2_bx = tmp_bx;
+    tmp2_bx.setRange(1, crse_bx.smallEnd(1), crse_bx.length(1));
+    FArrayBox tmp2fab(tmp2_bx, ncomp);
+    Elixir tmp2eli;
+    if (run_on_gpu) tmp2eli = tmp2fab.elixir();
+    Array4<Real> const& tmp2arr = tmp2fab.array();
+    Array4<Real const> const& ctmp2arr = tmp2fab.const_array();
+
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, tmp2_bx, tbx,
+    {
+        amrex::quartinterp_z(tbx, tmp2arr, 0, ncomp, crsearr, crse_comp);
+    });
+
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, tmp_bx, tbx,
+    {
+        amrex::quartinterp_y(tbx, tmparr, 0, ncomp, ctmp2arr, 0);
+    });
 #endif
 
-    amrex_quartinterp (fdat,AMREX_ARLIM(flo),AMREX_ARLIM(fhi),
-		      fblo, fbhi, fb2lo, fb2hi,
-		      cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),
-		      cblo, cbhi, cb2lo, cb2hi,
-		      &ncomp,
-		      AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
-		      AMREX_D_DECL(ftmp.dataPtr(), ctmp.dataPtr(), ctmp2.dataPtr()),
-		      bc.dataPtr(),&actual_comp,&actual_state);
-}
+    AMREX_LAUNCH_HOST_DEVICE_LAMBDA_FLAG (runon, target_fine_region, tbx,
+    {
+        amrex::quartinterp_x(tbx, finearr, fine_comp, ncomp, ctmparr, 0);
+    });
 #endif
+}
 
 }
@@ -497,6 +497,45 @@ TagBoxArray::mapPeriodic (const Geometry& geom)
     }
 }
 
+void
+TagBoxArray::removeDuplicates ()
+{
+    BL_PROFILE("TagBoxArray::removeDuplicates()");
+
+    // This function is called after coarsening.
+    // So we can assume that n_grow is 0.
+    BL_ASSERT(n_grow == IntVect::TheZeroVector());
+
+    const BoxArray& ba = boxArray();
+    if (ba.isDisjoint()) return;
+
+    TagBoxArray tmp(ba,DistributionMap()); // note that tmp is filled w/ CLEAR.
+
+    tmp.copy(*this, Periodicity::NonPeriodic(), FabArrayBase::ADD);
+
+    Gpu::LaunchSafeGuard lsg(false); // xxxxx TODO: gpu
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(*this); mfi.isValid(); ++mfi)
+    {
+        TagBox& tags = get(mfi);
+        tags.merge(tmp[mfi]);
+
+        std::vector< std::pair<int,Box> > isects;
+
+        ba.intersections(mfi.validbox(),isects);
+
+        for (int i = 0, N = isects.size(); i < N; i++)
+        {
+            if (isects[i].first < mfi.index()) {
+                tags.setVal<RunOn::Host>(TagBox::CLEAR,isects[i].second,0);
+            }
+        }
+    }
+}
+
 Long
 TagBoxArray::numTags () const
 {
@@ -518,11 +557,9 @@ TagBoxArray::numTags () const
 }
 
 void
-TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
+TagBoxArray::local_collate (Vector<IntVect>& TheLocalCollateSpace) const
 {
-    BL_PROFILE("TagBoxArray::collate()");
-
-    // Gpu::LaunchSafeGuard lsg(false); // xxxxx TODO: gpu
+    BL_PROFILE("TagBoxArray::local_collate()");
 
     Long count = 0;
 
@@ -534,10 +571,7 @@ TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
         count += get(fai).numTags();
     }
 
-    //
-    // Local space for holding just those tags we want to gather to the root cpu.
-    //
-    Vector<IntVect> TheLocalCollateSpace(count);
+    TheLocalCollateSpace.resize(count);
 
     count = 0;
 
@@ -550,8 +584,23 @@ TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
     if (count > 0)
     {
         amrex::RemoveDuplicates(TheLocalCollateSpace);
-        count = TheLocalCollateSpace.size();
     }
+}
+
+void
+TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
+{
+    BL_PROFILE("TagBoxArray::collate()");
+
+    // Gpu::LaunchSafeGuard lsg(false); // xxxxx TODO: gpu
+
+    //
+    // Local space for holding just those tags we want to gather to the root cpu.
+    //
+    Vector<IntVect> TheLocalCollateSpace;
+    local_collate(TheLocalCollateSpace);
+
+    Long count = TheLocalCollateSpace.size();
     //
     // The total number of tags system wide that must be collated.
     // This is really just an estimate of the upper bound due to duplicates.
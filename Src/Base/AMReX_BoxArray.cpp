@@ -5,6 +5,8 @@
 #include <AMReX_Utility.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_BaseFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_BLProfiler.H>
 
 #ifdef AMREX_MEM_PROFILING
 #include <AMReX_MemProfiler.H>
@@ -12,6 +14,8 @@
 
 #include <AMReX_OpenMP.H>
 
+#include <algorithm>
+
 namespace amrex {
 
 #ifdef AMREX_MEM_PROFILING
@@ -28,6 +32,15 @@ bool BoxArray::initialized = false;
 
 namespace {
     const int bl_ignore_max = 100000;
+    //
+    // Whether the hash of a BoxArray is a bucket grid (see BARef::multi_bin).
+    // -1: only if the largest Box is more than bucket_grid_ratio times the
+    // median Box in some direction, 0: never, 1: always.
+    //
+    int bucket_grid = -1;
+    int bucket_grid_ratio = 4;
+    // Boxes covering more bins than this are not put in the bucket grid.
+    const Long bucket_grid_max_bins = 512;
 }
 
 BARef::BARef () 
@@ -179,12 +192,34 @@ BARef::resize (Long n) {
 #endif
     m_abox.resize(n);
     hash.clear();
+    big_boxes.clear();
     has_hashmap = false;
 #ifdef AMREX_MEM_PROFILING
     updateMemoryUsage_box(1);
 #endif
 }
 
+void
+BARef::hashInsert (int i) const
+{
+    const Box& bx = m_abox[i];
+    if (multi_bin && bx.ok())
+    {
+        const Box& cbx = amrex::coarsen(bx, crsn);
+        if (cbx.numPts() > bucket_grid_max_bins) {
+            big_boxes.push_back(i);
+        } else {
+            for (IntVect iv = cbx.smallEnd(), End = cbx.bigEnd(); iv <= End; cbx.next(iv)) {
+                hash[iv].push_back(i);
+            }
+        }
+    }
+    else
+    {
+        hash[amrex::coarsen(bx.smallEnd(),crsn)].push_back(i);
+    }
+}
+
 #ifdef AMREX_MEM_PROFILING
 void
 BARef::updateMemoryUsage_box (int s)
@@ -258,6 +293,10 @@ BoxArray::Initialize ()
     if (!initialized) {
 	initialized = true;
 	BARef::Initialize();
+
+        ParmParse pp("boxarray");
+        pp.query("bucket_grid", bucket_grid);
+        pp.query("bucket_grid_ratio", bucket_grid_ratio);
     }
 
     amrex::ExecOnFinalize(BoxArray::Finalize);
@@ -1163,7 +1202,7 @@ BoxArray::intersections (const Box&                         bx,
 
     isects.resize(0);
 
-    if (!BoxHashMap.empty())
+    if (!BoxHashMap.empty() || !m_ref->big_boxes.empty())
     {
         BL_ASSERT(bx.ixType() == ixType());
 
@@ -1176,8 +1215,12 @@ BoxArray::intersections (const Box&                         bx,
 
 	gbx.setSmall(glo - doihi).setBig(ghi + doilo);
         gbx.refine(crseRatio()).coarsen(m_ref->crsn);
+
+        // In a bucket grid, the Boxes are in all the bins they cover.
+        const bool multi = m_ref->multi_bin;
 	
-        const IntVect& sm = amrex::max(gbx.smallEnd()-1, m_ref->bbox.smallEnd());
+        const IntVect& sm = amrex::max(multi ? gbx.smallEnd() : gbx.smallEnd()-1,
+                                       m_ref->bbox.smallEnd());
         const IntVect& bg = amrex::min(gbx.bigEnd(),     m_ref->bbox.bigEnd());
 
         Box cbx(sm,bg);
@@ -1188,6 +1231,14 @@ BoxArray::intersections (const Box&                         bx,
 	auto TheEnd = BoxHashMap.cend();
 
         auto& abox = m_ref->m_abox;
+        const IntVect& crsn = m_ref->crsn;
+
+        // A Box in several bins is only considered in the first bin visited.
+        auto other_bin = [&] (int index, IntVect const& iv) -> bool
+        {
+            return multi && amrex::max(amrex::coarsen(abox[index].smallEnd(),crsn),
+                                       cbx.smallEnd()) != iv;
+        };
 
         for (IntVect iv = cbx.smallEnd(), End = cbx.bigEnd(); iv <= End; cbx.next(iv))
         {
@@ -1198,6 +1249,8 @@ BoxArray::intersections (const Box&                         bx,
                 if (m_bat.is_null()) {
                     for (const int index : it->second)
                     {
+                        if (other_bin(index,iv)) continue;
+
                         const Box& ibox = abox[index];
                         const Box& isect = bx & amrex::grow(ibox,ng);
 
@@ -1212,6 +1265,8 @@ BoxArray::intersections (const Box&                         bx,
                     IntVect cr = crseRatio();
                     for (const int index : it->second)
                     {
+                        if (other_bin(index,iv)) continue;
+
                         const Box& ibox = amrex::convert(amrex::coarsen(abox[index],cr),t);
                         const Box& isect = bx & amrex::grow(ibox,ng);
 
@@ -1224,6 +1279,8 @@ BoxArray::intersections (const Box&                         bx,
                 } else {
                     for (const int index : it->second)
                     {
+                        if (other_bin(index,iv)) continue;
+
                         const Box& ibox = m_bat.m_op.m_bndryReg(abox[index]);
                         const Box& isect = bx & amrex::grow(ibox,ng);
 
@@ -1236,6 +1293,69 @@ BoxArray::intersections (const Box&                         bx,
                 }
             }
         }
+
+        for (const int index : m_ref->big_boxes)
+        {
+            const Box& isect = bx & amrex::grow((*this)[index],ng);
+
+            if (isect.ok())
+            {
+                isects.push_back(std::pair<int,Box>(index,isect));
+                if (first_only) return;
+            }
+        }
+    }
+}
+
+void
+BoxArray::intersections (const Vector<Box>& bxs, Vector<int>& offset,
+                         std::vector< std::pair<int,Box> >& isects,
+                         const IntVect& ng) const
+{
+    BL_PROFILE("BoxArray::intersections(Vector)");
+
+    const int nboxes = bxs.size();
+
+    offset.resize(nboxes+1);
+    offset[0] = 0;
+    isects.clear();
+
+    if (nboxes == 0) return;
+
+    getHashMap(); // so that the threads below do not wait for it
+
+    const int nthreads = (OpenMP::in_parallel()) ? 1 : std::min(OpenMP::get_max_threads(), nboxes);
+
+    Vector<std::vector< std::pair<int,Box> > > thread_isects(nthreads);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthreads)
+#endif
+    {
+        // The runtime may give us fewer threads than requested.
+        const int nt = OpenMP::get_num_threads();
+        const int tid = OpenMP::get_thread_num();
+        const int ibegin = static_cast<int>((Long(nboxes)* tid   ) / nt);
+        const int iend   = static_cast<int>((Long(nboxes)*(tid+1)) / nt);
+
+        auto& my_isects = thread_isects[tid];
+        std::vector< std::pair<int,Box> > tmp;
+
+        for (int i = ibegin; i < iend; ++i)
+        {
+            intersections(bxs[i], tmp, false, ng);
+            offset[i+1] = tmp.size();
+            my_isects.insert(my_isects.end(), tmp.begin(), tmp.end());
+        }
+    }
+
+    for (int i = 0; i < nboxes; ++i) {
+        offset[i+1] += offset[i];
+    }
+
+    isects.reserve(offset[nboxes]);
+    for (const auto& v : thread_isects) {
+        isects.insert(isects.end(), v.begin(), v.end());
     }
 }
 
@@ -1269,8 +1389,11 @@ BoxArray::complementIn (BoxList& bl, const Box& bx) const
 
 	gbx.setSmall(glo - doihi).setBig(ghi + doilo);
         gbx.refine(crseRatio()).coarsen(m_ref->crsn);
+
+        const bool multi = m_ref->multi_bin;
 	
-        const IntVect& sm = amrex::max(gbx.smallEnd()-1, m_ref->bbox.smallEnd());
+        const IntVect& sm = amrex::max(multi ? gbx.smallEnd() : gbx.smallEnd()-1,
+                                       m_ref->bbox.smallEnd());
         const IntVect& bg = amrex::min(gbx.bigEnd(),     m_ref->bbox.bigEnd());
 
         Box cbx(sm,bg);
@@ -1285,6 +1408,13 @@ BoxArray::complementIn (BoxList& bl, const Box& bx) const
         BoxList newdiff(bl.ixType());
 
         auto& abox = m_ref->m_abox;
+        const IntVect& crsn = m_ref->crsn;
+
+        auto other_bin = [&] (int index, IntVect const& iv) -> bool
+        {
+            return multi && amrex::max(amrex::coarsen(abox[index].smallEnd(),crsn),
+                                       cbx.smallEnd()) != iv;
+        };
 
 	for (IntVect iv = cbx.smallEnd(), End = cbx.bigEnd(); 
 	     iv <= End && bl.isNotEmpty(); 
@@ -1297,6 +1427,8 @@ BoxArray::complementIn (BoxList& bl, const Box& bx) const
                 if (m_bat.is_null()) {
                     for (const int index : it->second)
                     {
+                        if (other_bin(index,iv)) continue;
+
                         const Box& ibox = abox[index];
                         const Box& isect = bx & ibox;
 
@@ -1315,6 +1447,8 @@ BoxArray::complementIn (BoxList& bl, const Box& bx) const
                     IntVect cr = crseRatio();
                     for (const int index : it->second)
                     {
+                        if (other_bin(index,iv)) continue;
+
                         const Box& ibox = amrex::convert(amrex::coarsen(abox[index],cr),t);
                         const Box& isect = bx & ibox;
 
@@ -1331,6 +1465,8 @@ BoxArray::complementIn (BoxList& bl, const Box& bx) const
                 } else {
                     for (const int index : it->second)
                     {
+                        if (other_bin(index,iv)) continue;
+
                         const Box& ibox = m_bat.m_op.m_bndryReg(abox[index]);
                         const Box& isect = bx & ibox;
 
@@ -1347,18 +1483,36 @@ BoxArray::complementIn (BoxList& bl, const Box& bx) const
                 }
             }
         }
+
+        for (const int index : m_ref->big_boxes)
+        {
+            if (bl.isEmpty()) break;
+
+            const Box& isect = bx & (*this)[index];
+
+            if (isect.ok())
+            {
+                newbl.clear();
+                for (const Box& b : bl) {
+                    amrex::boxDiff(newdiff, b, isect);
+                    newbl.join(newdiff);
+                }
+                bl.swap(newbl);
+            }
+        }
     }
 }
 
 void
 BoxArray::clear_hash_bin () const
 {
-    if (!m_ref->hash.empty())
+    if (!m_ref->hash.empty() || !m_ref->big_boxes.empty())
     {
 #ifdef AMREX_MEM_PROFILING
 	m_ref->updateMemoryUsage_hash(-1);
 #endif
         m_ref->hash.clear();
+        m_ref->big_boxes.clear();
         m_ref->has_hashmap = false;
     }
 }
@@ -1379,8 +1533,6 @@ BoxArray::removeOverlap (bool simplify)
 
     uniqify();
 
-    BARef::HashType& BoxHashMap = m_ref->hash;
-
     const Box EmptyBox;
 
     std::vector< std::pair<int,Box> > isects;
@@ -1414,7 +1566,7 @@ BoxArray::removeOverlap (bool simplify)
                 for (const Box& b : bl_diff)
                 {
                     m_ref->m_abox.push_back(b);
-                    BoxHashMap[amrex::coarsen(b.smallEnd(),m_ref->crsn)].push_back(size()-1);
+                    m_ref->hashInsert(size()-1);
                 }
             }
         }
@@ -1484,7 +1636,7 @@ BoxArray::getHashMap () const
 #pragma omp critical(intersections_lock)
 #endif
     {
-        if (BoxHashMap.empty() && size() > 0)
+        if (BoxHashMap.empty() && m_ref->big_boxes.empty() && size() > 0)
         {
             //
             // Calculate the bounding box & maximum extent of the boxes.
@@ -1501,15 +1653,43 @@ BoxArray::getHashMap () const
                 boundingbox.minBox(bx);
             }
 
+            //
+            // The bins are as large as the largest box, so that a box only
+            // needs to be in the bin of its small end.  If the box sizes vary
+            // a lot, most boxes end up in a few bins.  Then we use a bucket
+            // grid with bins of the median box size instead.
+            //
+            IntVect binsize = maxext;
+            bool multi = false;
+            if (bucket_grid != 0 && N > 1)
+            {
+                IntVect medext;
+                std::vector<int> ext(N);
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+                {
+                    for (int i = 0; i < N; ++i) {
+                        Box bx = m_ref->m_abox[i];
+                        bx.normalize();
+                        ext[i] = bx.length(idim);
+                    }
+                    std::nth_element(ext.begin(), ext.begin()+N/2, ext.end());
+                    medext[idim] = std::max(ext[N/2], 1);
+                }
+                multi = (bucket_grid == 1) || !(maxext <= bucket_grid_ratio*medext);
+                if (multi) {
+                    binsize = medext;
+                }
+            }
+
+            m_ref->crsn = binsize;
+            m_ref->multi_bin = multi;
+
             for (int i = 0; i < N; i++)
             {
-                const IntVect& crsnsmlend 
-		    = amrex::coarsen(m_ref->m_abox[i].smallEnd(),maxext);
-                BoxHashMap[crsnsmlend].push_back(i);
+                m_ref->hashInsert(i);
             }
 
-            m_ref->crsn = maxext;
-            m_ref->bbox = boundingbox.coarsen(maxext);
+            m_ref->bbox = boundingbox.coarsen(binsize);
             m_ref->bbox.normalize();
 
 #ifdef AMREX_MEM_PROFILING
@@ -0,0 +1,349 @@
+
+#include <AMReX_DistributedBoxArray.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelContext.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_BoxIterator.H>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+namespace amrex {
+
+namespace {
+
+// A box record: kind, global index, owner, shift index, small end, big end and index type.
+constexpr int nrec = 4 + 3*AMREX_SPACEDIM;
+
+void
+pack_box (Vector<int>& buf, int kind, int gidx, int owner, int ishift, const Box& bx)
+{
+    buf.push_back(kind);
+    buf.push_back(gidx);
+    buf.push_back(owner);
+    buf.push_back(ishift);
+    const IntVect& typ = bx.ixType().ixType();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) buf.push_back(bx.smallEnd(idim));
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) buf.push_back(bx.bigEnd(idim));
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) buf.push_back(typ[idim]);
+}
+
+Box
+unpack_box (const int* p)
+{
+    return Box(IntVect(p+4), IntVect(p+4+AMREX_SPACEDIM), IndexType(IntVect(p+4+2*AMREX_SPACEDIM)));
+}
+
+// Sends snd[p] to process p of the current ParallelContext and concatenates
+// the received buffers in rcv.  A process does not know who sends to it, so
+// this is a non-blocking consensus: the messages are sent with synchronous
+// sends, and a process enters a non-blocking barrier once all its messages
+// have been received.  It receives until the barrier completes, i.e., until
+// every message has been received.  Only the processes that exchange data
+// communicate, and the barrier costs O(log P).
+void
+sparse_exchange (const std::map<int,Vector<int> >& snd, Vector<int>& rcv)
+{
+    rcv.clear();
+
+#ifdef AMREX_USE_MPI
+    const int myproc = ParallelContext::MyProcSub();
+    MPI_Comm  comm   = ParallelContext::CommunicatorSub();
+    const int seqno  = ParallelDescriptor::SeqNum();
+
+    Vector<MPI_Request> reqs;
+    for (const auto& kv : snd) {
+        if (kv.second.empty()) continue;
+        if (kv.first == myproc) {
+            rcv.insert(rcv.end(), kv.second.begin(), kv.second.end());
+        } else {
+            reqs.push_back(MPI_REQUEST_NULL);
+            BL_MPI_REQUIRE( MPI_Issend(const_cast<int*>(kv.second.data()), kv.second.size(),
+                                       MPI_INT, kv.first, seqno, comm, &reqs.back()) );
+        }
+    }
+
+    MPI_Request barrier = MPI_REQUEST_NULL;
+    bool in_barrier = false;
+    while (true)
+    {
+        int flag;
+        MPI_Status stat;
+        BL_MPI_REQUIRE( MPI_Iprobe(MPI_ANY_SOURCE, seqno, comm, &flag, &stat) );
+        if (flag) {
+            int n;
+            BL_MPI_REQUIRE( MPI_Get_count(&stat, MPI_INT, &n) );
+            const Long offset = rcv.size();
+            rcv.resize(offset+n);
+            BL_MPI_REQUIRE( MPI_Recv(rcv.data()+offset, n, MPI_INT, stat.MPI_SOURCE,
+                                     seqno, comm, MPI_STATUS_IGNORE) );
+        }
+
+        if (in_barrier) {
+            BL_MPI_REQUIRE( MPI_Test(&barrier, &flag, MPI_STATUS_IGNORE) );
+            if (flag) break;
+        } else {
+            BL_MPI_REQUIRE( MPI_Testall(reqs.size(), reqs.data(), &flag, MPI_STATUSES_IGNORE) );
+            if (flag) {
+                BL_MPI_REQUIRE( MPI_Ibarrier(comm, &barrier) );
+                in_barrier = true;
+            }
+        }
+    }
+#else
+    for (const auto& kv : snd) {
+        rcv.insert(rcv.end(), kv.second.begin(), kv.second.end());
+    }
+#endif
+}
+
+}
+
+DistributedBoxArray::DistributedBoxArray (Vector<Box> boxes, Vector<int> gidx)
+{
+    define(std::move(boxes), std::move(gidx));
+}
+
+DistributedBoxArray::DistributedBoxArray (const BoxArray& ba, const DistributionMapping& dm)
+{
+    define(ba, dm);
+}
+
+void
+DistributedBoxArray::define (Vector<Box> boxes, Vector<int> gidx)
+{
+    AMREX_ASSERT(boxes.size() == gidx.size());
+    m_boxes = std::move(boxes);
+    m_gidx  = std::move(gidx);
+    m_halo_boxes = BoxArray();
+    m_halo_gidx.clear();
+    m_halo_owner.clear();
+    m_halo_map.clear();
+}
+
+void
+DistributedBoxArray::define (const BoxArray& ba, const DistributionMapping& dm)
+{
+    const int myproc = ParallelDescriptor::MyProc();
+    Vector<Box> boxes;
+    Vector<int> gidx;
+    for (int i = 0, N = ba.size(); i < N; ++i) {
+        if (dm[i] == myproc) {
+            boxes.push_back(ba[i]);
+            gidx.push_back(i);
+        }
+    }
+    define(std::move(boxes), std::move(gidx));
+}
+
+void
+DistributedBoxArray::defineHalo (const DistributedBoxArray& src, const IntVect& ng,
+                                 const IntVect& ng_src, const Periodicity& period)
+{
+    BL_PROFILE("DistributedBoxArray::defineHalo()");
+
+    const int nprocs = ParallelContext::NProcsSub();
+    const int myproc = ParallelDescriptor::MyProc();
+    const std::vector<IntVect>& pshifts = period.shiftIntVect();
+
+    // The bin grid covers the grown local boxes of this, and the bin size is
+    // the size of the largest of them.  So every query touches at most
+    // 2^AMREX_SPACEDIM bins.
+    IntVect lo(std::numeric_limits<int>::max());
+    IntVect hi(-std::numeric_limits<int>::max());
+    IntVect binsize(1);
+    for (const auto& b : m_boxes) {
+        const Box& gb = amrex::grow(b,ng);
+        lo.min(gb.smallEnd());
+        hi.max(gb.bigEnd());
+        binsize.max(gb.length());
+    }
+
+    Array<int,3*AMREX_SPACEDIM> r;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        r[idim]                  =  lo[idim];
+        r[idim+AMREX_SPACEDIM]   = -hi[idim];
+        r[idim+2*AMREX_SPACEDIM] = -binsize[idim];
+    }
+    ParallelAllReduce::Min(r.data(), r.size(), ParallelContext::CommunicatorSub());
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        lo[idim]      =  r[idim];
+        hi[idim]      = -r[idim+AMREX_SPACEDIM];
+        binsize[idim] = -r[idim+2*AMREX_SPACEDIM];
+    }
+
+    std::vector< std::pair<int,int> > halo; // (global index, record)
+    Vector<int> rbuf;
+
+    if (lo.allLE(hi))
+    {
+        const IntVect nbins = (hi-lo)/binsize + 1;
+
+        // Processes owning the bins touched by bx
+        auto bin_owners = [&] (const Box& bx, std::vector<int>& owners)
+        {
+            owners.clear();
+            const IntVect blo = (amrex::max(bx.smallEnd(),lo) - lo) / binsize;
+            const IntVect bhi = (amrex::min(bx.bigEnd()  ,hi) - lo) / binsize;
+            if (!blo.allLE(bhi)) return;
+            const Box bins(blo,bhi);
+            for (BoxIterator bi(bins); bi.ok(); ++bi) {
+                const IntVect& iv = bi();
+                Long ibin = iv[AMREX_SPACEDIM-1];
+                for (int idim = AMREX_SPACEDIM-2; idim >= 0; --idim) {
+                    ibin = ibin*nbins[idim] + iv[idim];
+                }
+                owners.push_back(static_cast<int>(ibin % nprocs));
+            }
+            std::sort(owners.begin(), owners.end());
+            owners.erase(std::unique(owners.begin(), owners.end()), owners.end());
+        };
+
+        std::map<int,Vector<int> > snd;
+        std::vector<int> owners;
+
+        for (int i = 0, N = m_boxes.size(); i < N; ++i) {
+            const Box& gb = amrex::grow(m_boxes[i],ng);
+            bin_owners(gb, owners);
+            for (int p : owners) {
+                pack_box(snd[p], 0, m_gidx[i], myproc, 0, gb);
+            }
+        }
+
+        for (int i = 0, N = src.m_boxes.size(); i < N; ++i) {
+            const Box& gb = amrex::grow(src.m_boxes[i],ng_src);
+            for (int ishift = 0, nshifts = pshifts.size(); ishift < nshifts; ++ishift) {
+                bin_owners(gb+pshifts[ishift], owners);
+                for (int p : owners) {
+                    pack_box(snd[p], 1, src.m_gidx[i], myproc, ishift, src.m_boxes[i]);
+                }
+            }
+        }
+
+        sparse_exchange(snd, rbuf);
+        snd.clear();
+
+        // Rendezvous: match the queries with the source images in our bins.
+        // Index types are ignored here, as only the index ranges matter.
+        BoxList images;
+        Vector<int> image_rec;
+        Vector<Box> queries;
+        Vector<int> query_rec;
+        for (int irec = 0, N = rbuf.size()/nrec; irec < N; ++irec) {
+            const int* p = rbuf.data() + irec*nrec;
+            const Box& bx = unpack_box(p);
+            if (p[0] == 0) {
+                queries.push_back(Box(bx.smallEnd(), bx.bigEnd()));
+                query_rec.push_back(irec);
+            } else {
+                const Box& gb = amrex::grow(bx,ng_src) + pshifts[p[3]];
+                images.push_back(Box(gb.smallEnd(), gb.bigEnd()));
+                image_rec.push_back(irec);
+            }
+        }
+
+        if (!queries.empty() && !images.isEmpty())
+        {
+            const BoxArray image_ba(std::move(images));
+            Vector<int> offset;
+            std::vector< std::pair<int,Box> > isects;
+            image_ba.intersections(queries, offset, isects);
+
+            std::vector< std::pair<int,int> > matches; // (process, record)
+            for (int iq = 0, N = queries.size(); iq < N; ++iq) {
+                const int* p = rbuf.data() + query_rec[iq]*nrec;
+                const int dest = ParallelContext::global_to_local_rank(p[2]);
+                for (int j = offset[iq]; j < offset[iq+1]; ++j) {
+                    matches.push_back(std::make_pair(dest, image_rec[isects[j].first]));
+                }
+            }
+
+            // Each source box is returned once to each process, even if several
+            // of its images match.
+            auto gidx_of = [&] (const std::pair<int,int>& m) { return rbuf[m.second*nrec+1]; };
+            std::sort(matches.begin(), matches.end(),
+                      [&] (const std::pair<int,int>& a, const std::pair<int,int>& b) {
+                          return a.first < b.first
+                              || (a.first == b.first && gidx_of(a) < gidx_of(b));
+                      });
+            matches.erase(std::unique(matches.begin(), matches.end(),
+                                      [&] (const std::pair<int,int>& a, const std::pair<int,int>& b) {
+                                          return a.first == b.first && gidx_of(a) == gidx_of(b);
+                                      }),
+                          matches.end());
+
+            for (const auto& m : matches) {
+                const int* p = rbuf.data() + m.second*nrec;
+                pack_box(snd[m.first], 1, p[1], p[2], 0, unpack_box(p));
+            }
+        }
+
+        sparse_exchange(snd, rbuf);
+
+        for (int irec = 0, N = rbuf.size()/nrec; irec < N; ++irec) {
+            halo.push_back(std::make_pair(rbuf[irec*nrec+1], irec));
+        }
+        std::sort(halo.begin(), halo.end());
+        halo.erase(std::unique(halo.begin(), halo.end(),
+                               [] (const std::pair<int,int>& a, const std::pair<int,int>& b) {
+                                   return a.first == b.first;
+                               }),
+                   halo.end());
+    }
+
+    m_halo_gidx.resize(halo.size());
+    m_halo_owner.resize(halo.size());
+    m_halo_map.clear();
+    BoxList bl;
+    for (int i = 0, N = halo.size(); i < N; ++i) {
+        const int* p = rbuf.data() + halo[i].second*nrec;
+        const Box& bx = unpack_box(p);
+        if (i == 0) bl.set(bx.ixType());
+        bl.push_back(bx);
+        m_halo_gidx[i]  = p[1];
+        m_halo_owner[i] = p[2];
+        m_halo_map[p[1]] = i;
+    }
+    m_halo_boxes = BoxArray(std::move(bl));
+}
+
+void
+DistributedBoxArray::intersections (const Box& bx, std::vector< std::pair<int,Box> >& isects,
+                                    const IntVect& ng) const
+{
+    isects.clear();
+    if (m_halo_boxes.empty()) return;
+    m_halo_boxes.intersections(bx, isects, false, ng);
+    for (auto& is : isects) {
+        is.first = m_halo_gidx[is.first];
+    }
+}
+
+void
+DistributedBoxArray::intersections (const Vector<Box>& bxs, Vector<int>& offset,
+                                    std::vector< std::pair<int,Box> >& isects,
+                                    const IntVect& ng) const
+{
+    if (m_halo_boxes.empty()) {
+        offset.assign(bxs.size()+1, 0);
+        isects.clear();
+        return;
+    }
+    m_halo_boxes.intersections(bxs, offset, isects, ng);
+    for (auto& is : isects) {
+        is.first = m_halo_gidx[is.first];
+    }
+}
+
+Long
+DistributedBoxArray::bytes () const
+{
+    return m_boxes.capacity()*sizeof(Box) + m_gidx.capacity()*sizeof(int)
+        + m_halo_boxes.size()*sizeof(Box)
+        + (m_halo_gidx.capacity() + m_halo_owner.capacity())*sizeof(int)
+        + m_halo_map.size()*(2*sizeof(int)+sizeof(void*));
+}
+
+}
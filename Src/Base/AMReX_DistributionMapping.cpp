@@ -1633,6 +1633,70 @@ DistributionMapping::makeRoundRobin (const MultiFab& weight)
     return r;
 }
 
+DistributionMapping
+DistributionMapping::makeIncremental (const BoxArray& ba, const BoxArray& old_ba,
+                                      const DistributionMapping& old_dm)
+{
+    BL_PROFILE("makeIncremental");
+
+    const int N = ba.size();
+    const int nprocs = ParallelContext::NProcsSub();
+
+    Vector<int> pmap(N, -1);
+    Vector<Long> load(nprocs, 0L);
+    Vector<int> newboxes;
+
+    std::vector< std::pair<int,Box> > isects;
+    for (int i = 0; i < N; ++i)
+    {
+        const Box& bx = ba[i];
+        old_ba.intersections(bx, isects);
+        for (const auto& is : isects) {
+            if (is.second == bx && old_ba[is.first] == bx) {
+                pmap[i] = old_dm[is.first];
+                break;
+            }
+        }
+        if (pmap[i] >= 0 && pmap[i] < nprocs) {
+            load[pmap[i]] += bx.numPts();
+        } else {
+            pmap[i] = -1;
+            newboxes.push_back(i);
+        }
+    }
+
+    if (static_cast<int>(newboxes.size()) == N) {
+        // Nothing to reuse.  Use the default strategy.
+        return DistributionMapping(ba, nprocs);
+    }
+
+    // Largest boxes first, each to the least loaded process.
+    std::stable_sort(newboxes.begin(), newboxes.end(),
+                     [&ba] (int a, int b) { return ba[a].numPts() > ba[b].numPts(); });
+
+    using LIpair = std::pair<Long,int>;
+    std::priority_queue<LIpair, std::vector<LIpair>, std::greater<LIpair> > procs;
+    for (int p = 0; p < nprocs; ++p) {
+        procs.push(LIpair(load[p], p));
+    }
+
+    for (int i : newboxes)
+    {
+        LIpair lp = procs.top();
+        procs.pop();
+        pmap[i] = lp.second;
+        lp.first += ba[i].numPts();
+        procs.push(lp);
+    }
+
+    if (verbose) {
+        amrex::Print() << "DistributionMapping::makeIncremental: kept "
+                       << N - newboxes.size() << " of " << N << " boxes\n";
+    }
+
+    return DistributionMapping(std::move(pmap));
+}
+
 DistributionMapping
 DistributionMapping::makeSFC (const MultiFab& weight, bool sort)
 {
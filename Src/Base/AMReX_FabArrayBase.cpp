@@ -1,9 +1,13 @@
 
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 #include <AMReX_FabArrayBase.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Utility.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_DistributedBoxArray.H>
+#include <AMReX_ParallelReduce.H>
 #include <AMReX_FArrayBox.H>
 
 #include <AMReX_BArena.H>
@@ -74,12 +78,155 @@ FabArrayBase::FabArrayStats        FabArrayBase::m_FA_stats;
 std::map<std::string,FabArrayBase::meminfo> FabArrayBase::m_mem_usage;
 std::vector<std::string>                    FabArrayBase::m_region_tag;
 
+bool FabArrayBase::comm_pattern_profiling = false;
+bool FabArrayBase::use_rendezvous = false;
+
 namespace
 {
     Arena* the_fa_arena = nullptr;
     bool initialized = false;
+
+    // The id of a plan is a hash of what it is built from, so that the
+    // processes that build the same plan give it the same id, whether or not
+    // the other processes build it, and whatever their caches hold.
+    struct PlanHash
+    {
+        ULong h = 14695981039346656037ULL;
+        void add (ULong v) noexcept {
+            h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        }
+        void add (const IntVect& iv) noexcept {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                add(static_cast<ULong>(static_cast<Long>(iv[idim])));
+            }
+        }
+        void add (const Box& bx) noexcept {
+            add(bx.smallEnd());
+            add(bx.bigEnd());
+            add(bx.type());
+        }
+        void add (const BoxArray& ba) noexcept {
+            add(static_cast<ULong>(ba.size()));
+            for (int i = 0, N = ba.size(); i < N; ++i) {
+                add(ba[i]);
+            }
+        }
+        void add (const DistributionMapping& dm) noexcept {
+            for (int p : dm.ProcessorMap()) {
+                add(static_cast<ULong>(p));
+            }
+        }
+        void add (const Periodicity& period) noexcept {
+            add(period.Domain());
+        }
+    };
+
+    // Communication pattern of a plan aggregated over its lifetime
+    struct CommPattern
+    {
+        std::string kind;
+        std::string tag;
+        Long ncomm = 0;
+        std::map<int,std::pair<Long,Long> > to; // dst rank -> (bytes, messages)
+    };
+    std::map<ULong,CommPattern> comm_patterns;
+
+    void recordCommPattern (const char* kind, FabArrayBase::CommMetaData const& cmd)
+    {
+        if (!FabArrayBase::comm_pattern_profiling || cmd.m_ncomm == 0) return;
+
+        CommPattern& cp = comm_patterns[cmd.m_plan_id];
+        cp.kind = kind;
+        cp.tag = cmd.m_plan_tag;
+        cp.ncomm += cmd.m_ncomm;
+
+        auto add = [&] (int rank, FabArrayBase::CopyComTagsContainer const& tags)
+        {
+            Long npts = 0;
+            for (auto const& tag : tags) {
+                npts += tag.sbox.numPts();
+            }
+            auto& entry = cp.to[rank];
+            entry.first  += npts * cmd.m_bytes_per_pt;
+            entry.second += cmd.m_ncomm;
+        };
+
+        if (cmd.m_LocTags && !cmd.m_LocTags->empty()) {
+            add(ParallelDescriptor::MyProc(), *cmd.m_LocTags);
+        }
+        if (cmd.m_SndTags) {
+            for (auto const& kv : *cmd.m_SndTags) {
+                add(kv.first, kv.second);
+            }
+        }
+
+        // The plan may be used again if it is still alive.
+        cmd.m_ncomm = 0;
+        cmd.m_bytes_per_pt = 0;
+    }
+
+    ULong planId (const BoxArray& dstba, const DistributionMapping& dstdm, const IntVect& dstng,
+                  const BoxArray& srcba, const DistributionMapping& srcdm, const IntVect& srcng,
+                  const Periodicity& period)
+    {
+        PlanHash ph;
+        ph.add(0x435043ULL); // "CPC"
+        ph.add(dstba);
+        ph.add(dstdm);
+        ph.add(dstng);
+        ph.add(srcba);
+        ph.add(srcdm);
+        ph.add(srcng);
+        ph.add(period);
+        return ph.h;
+    }
+
+    // The local boxes of ba and their global indices.
+    DistributedBoxArray localBoxes (const BoxArray& ba, const Vector<int>& imap)
+    {
+        Vector<Box> boxes;
+        boxes.reserve(imap.size());
+        for (int k : imap) boxes.push_back(ba[k]);
+        return DistributedBoxArray(std::move(boxes), imap);
+    }
+
+    // The rendezvous of FB::define_fb.  This is collective.
+    DistributedBoxArray fbHalo (const BoxArray& ba, const Vector<int>& imap,
+                                const IntVect& ng, const Periodicity& period)
+    {
+        DistributedBoxArray dba = localBoxes(ba, imap);
+        dba.defineHalo(dba, ng, ng, period);
+        return dba;
+    }
+
+    // The rendezvous of CPC::define.  This is collective.
+    void cpcHalo (const BoxArray& ba_dst, const Vector<int>& imap_dst, const IntVect& ng_dst,
+                  const BoxArray& ba_src, const Vector<int>& imap_src, const IntVect& ng_src,
+                  const Periodicity& period,
+                  DistributedBoxArray& dba_dst, DistributedBoxArray& dba_src)
+    {
+        dba_src = localBoxes(ba_src, imap_src);
+        dba_dst = localBoxes(ba_dst, imap_dst);
+        dba_src.defineHalo(dba_dst, ng_src, ng_dst, period);
+        dba_dst.defineHalo(dba_src, ng_dst, ng_src, period);
+    }
+
+    // The caches are per process.  With the rendezvous, the plans are built
+    // collectively, so a process that has the plan in its cache still takes
+    // part in the rendezvous when another process does not have it.  Returns
+    // true if some process has to build the plan.
+    bool anyBuilds (bool found)
+    {
+        int build = found ? 0 : 1;
+        ParallelAllReduce::Max(build, ParallelContext::CommunicatorSub());
+        return build != 0;
+    }
 }
 
+FabArrayBase::CommMetaData::CommMetaData () noexcept
+    : m_plan_tag(m_region_tag.empty() ? std::string("-") : m_region_tag.back())
+{}
+
 void
 FabArrayBase::Initialize ()
 {
@@ -111,6 +258,8 @@ FabArrayBase::Initialize ()
     }
 
     pp.query("maxcomp",             FabArrayBase::MaxComp);
+    pp.query("comm_pattern",        FabArrayBase::comm_pattern_profiling);
+    pp.query("rendezvous",          FabArrayBase::use_rendezvous);
 
     if (MaxComp < 1) {
         MaxComp = 1;
@@ -296,8 +445,11 @@ FabArrayBase::CPC::CPC (const FabArrayBase& dstfa, const IntVect& dstng,
       m_dstba(dstfa.boxArray()),
       m_nuse(0)
 {
+    m_plan_id = planId(m_dstba, dstfa.DistributionMap(), dstng,
+                       m_srcba, srcfa.DistributionMap(), srcng, period);
     this->define(m_dstba, dstfa.DistributionMap(), dstfa.IndexArray(), 
-		 m_srcba, srcfa.DistributionMap(), srcfa.IndexArray());
+		 m_srcba, srcfa.DistributionMap(), srcfa.IndexArray(),
+                 ParallelDescriptor::MyProc(), FabArrayBase::use_rendezvous);
 }
 
 FabArrayBase::CPC::CPC (const BoxArray& dstba, const DistributionMapping& dstdm, 
@@ -314,18 +466,21 @@ FabArrayBase::CPC::CPC (const BoxArray& dstba, const DistributionMapping& dstdm,
       m_dstba(dstba),
       m_nuse(0)
 {
+    m_plan_id = planId(dstba, dstdm, dstng, srcba, srcdm, srcng, period);
     this->define(dstba, dstdm, dstidx, srcba, srcdm, srcidx, myproc);
 }
 
 FabArrayBase::CPC::~CPC ()
-{}
+{
+    recordCommPattern("CPC", *this);
+}
 
 void
 FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm_dst,
 			   const Vector<int>& imap_dst,
 			   const BoxArray& ba_src, const DistributionMapping& dm_src,
 			   const Vector<int>& imap_src,
-			   int MyProc)
+			   int MyProc, bool rendezvous)
 {
     BL_PROFILE("FabArrayBase::CPC::define()");
 
@@ -336,6 +491,19 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
     m_SndTags.reset(new CopyComTag::MapOfCopyComTagContainers);
     m_RcvTags.reset(new CopyComTag::MapOfCopyComTagContainers);
 
+    // With the rendezvous, the source processes only know the destination
+    // boxes near their boxes and vice versa.  This is collective.
+    std::unique_ptr<DistributedBoxArray> dba_src, dba_dst;
+    if (rendezvous)
+    {
+        dba_src.reset(new DistributedBoxArray);
+        dba_dst.reset(new DistributedBoxArray);
+        cpcHalo(ba_dst, imap_dst, m_dstng, ba_src, imap_src, m_srcng, m_period, *dba_dst, *dba_src);
+    }
+
+    auto dst_owner_of = [&] (int k) { return (dba_src) ? dba_src->haloOwner(k) : dm_dst[k]; };
+    auto src_owner_of = [&] (int k) { return (dba_dst) ? dba_dst->haloOwner(k) : dm_src[k]; };
+
     if (!(imap_dst.empty() && imap_src.empty())) 
     {
 	const int nlocal_src = imap_src.size();
@@ -344,30 +512,48 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
 	const IntVect& ng_dst = m_dstng;
 
 	std::vector< std::pair<int,Box> > isects;
+        Vector<int> isects_offset;
+        Vector<Box> query;
 
 	const std::vector<IntVect>& pshifts = m_period.shiftIntVect();
+        const int nshifts = pshifts.size();
 
 	auto& send_tags = *m_SndTags;
+
+        query.reserve(nlocal_src*nshifts);
+	for (int i = 0; i < nlocal_src; ++i)
+	{
+	    const Box& bx_src = amrex::grow(ba_src[imap_src[i]], ng_src);
+            for (const auto& iv : pshifts) {
+                query.push_back(bx_src+iv);
+            }
+        }
+
+        if (dba_src) {
+            dba_src->intersections(query, isects_offset, isects, ng_dst);
+        } else {
+            ba_dst.intersections(query, isects_offset, isects, ng_dst);
+        }
 	
 	for (int i = 0; i < nlocal_src; ++i)
 	{
 	    const int   k_src = imap_src[i];
-	    const Box& bx_src = amrex::grow(ba_src[k_src], ng_src);
 
-	    for (std::vector<IntVect>::const_iterator pit=pshifts.begin(); pit!=pshifts.end(); ++pit)
+	    for (int ishift = 0; ishift < nshifts; ++ishift)
 	    {
-		ba_dst.intersections(bx_src+(*pit), isects, false, ng_dst);
+                const IntVect& shift = pshifts[ishift];
+                const int iq = i*nshifts + ishift;
 	    
-		for (int j = 0, M = isects.size(); j < M; ++j)
+		for (int j = isects_offset[iq], M = isects_offset[iq+1]; j < M; ++j)
 		{
 		    const int k_dst     = isects[j].first;
 		    const Box& bx       = isects[j].second;
-		    const int dst_owner = dm_dst[k_dst];
+		    const int dst_owner = dst_owner_of(k_dst);
 		
 		    if (ParallelDescriptor::sameTeam(dst_owner)) {
 			continue; // local copy will be dealt with later
 		    } else if (MyProc == dm_src[k_src]) {
-			send_tags[dst_owner].push_back(CopyComTag(bx, bx-(*pit), k_dst, k_src));
+			send_tags[dst_owner].push_back(CopyComTag(bx, bx-shift, k_dst, k_src));
 		    }
 		}
 	    }
@@ -394,6 +580,22 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
         m_threadsafe_loc = not check_local;
         m_threadsafe_rcv = not check_remote;
 
+        query.clear();
+        query.reserve(nlocal_dst*nshifts);
+	for (int i = 0; i < nlocal_dst; ++i)
+	{
+	    const Box& bx_dst = amrex::grow(ba_dst[imap_dst[i]], ng_dst);
+            for (const auto& iv : pshifts) {
+                query.push_back(bx_dst+iv);
+            }
+        }
+
+        if (dba_dst) {
+            dba_dst->intersections(query, isects_offset, isects, ng_src);
+        } else {
+            ba_src.intersections(query, isects_offset, isects, ng_src);
+        }
+
 	for (int i = 0; i < nlocal_dst; ++i)
 	{
 	    const int   k_dst = imap_dst[i];
@@ -409,15 +611,16 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
 		remotetouch.setVal<RunOn::Host>(0);
 	    }
 	    
-	    for (std::vector<IntVect>::const_iterator pit=pshifts.begin(); pit!=pshifts.end(); ++pit)
+	    for (int ishift = 0; ishift < nshifts; ++ishift)
 	    {
-		ba_src.intersections(bx_dst+(*pit), isects, false, ng_src);
+                const IntVect& shift = pshifts[ishift];
+                const int iq = i*nshifts + ishift;
 	    
-		for (int j = 0, M = isects.size(); j < M; ++j)
+		for (int j = isects_offset[iq], M = isects_offset[iq+1]; j < M; ++j)
 		{
 		    const int k_src     = isects[j].first;
-		    const Box& bx       = isects[j].second - *pit;
-		    const int src_owner = dm_src[k_src];
+		    const Box& bx       = isects[j].second - shift;
+		    const int src_owner = src_owner_of(k_src);
 		
 		    if (ParallelDescriptor::sameTeam(src_owner, MyProc)) { // local copy
 			const BoxList tilelist(bx, FabArrayBase::comm_tile_size);
@@ -425,13 +628,13 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
 				 it_tile  = tilelist.begin(),
 				 End_tile = tilelist.end();   it_tile != End_tile; ++it_tile)
 			{
-			    m_LocTags->push_back(CopyComTag(*it_tile, (*it_tile)+(*pit), k_dst, k_src));
+			    m_LocTags->push_back(CopyComTag(*it_tile, (*it_tile)+shift, k_dst, k_src));
 			}
 			if (check_local) {
 			    localtouch.plus<RunOn::Host>(1, bx);
 			}
 		    } else if (MyProc == dm_dst[k_dst]) {
-			recv_tags[src_owner].push_back(CopyComTag(bx, bx+(*pit), k_dst, k_src));
+			recv_tags[src_owner].push_back(CopyComTag(bx, bx+shift, k_dst, k_src));
 			if (check_remote) {
 			    remotetouch.plus<RunOn::Host>(1, bx);
 			}
@@ -476,6 +679,8 @@ FabArrayBase::CPC::CPC (const BoxArray& ba, const IntVect& ng,
 {
     BL_ASSERT(ba.size() > 0);
 
+    m_plan_id = planId(ba, dstdm, ng, ba, srcdm, ng, m_period);
+
     m_LocTags.reset(new CopyComTag::CopyComTagsContainer);
     m_SndTags.reset(new CopyComTag::MapOfCopyComTagContainers);
     m_RcvTags.reset(new CopyComTag::MapOfCopyComTagContainers);
@@ -580,6 +785,7 @@ FabArrayBase::getCPC (const IntVect& dstng, const FabArrayBase& src, const IntVe
 
     std::pair<CPCacheIter,CPCacheIter> er_it = m_TheCPCache.equal_range(dstkey);
 
+    CPC* found = nullptr;
     for (CPCacheIter it = er_it.first; it != er_it.second; ++it)
     {
 	if (it->second->m_srcng  == srcng &&
@@ -590,11 +796,26 @@ FabArrayBase::getCPC (const IntVect& dstng, const FabArrayBase& src, const IntVe
 	    it->second->m_srcba  == src.boxArray() &&
 	    it->second->m_dstba  == boxArray())
 	{
-	    ++(it->second->m_nuse);
-	    m_CPC_stats.recordUse();
-	    return *(it->second);
+	    found = it->second;
+	    break;
+	}
+    }
+
+    if (FabArrayBase::use_rendezvous)
+    {
+	if (anyBuilds(found != nullptr) && found) {
+	    DistributedBoxArray dba_dst, dba_src;
+	    cpcHalo(boxArray(), IndexArray(), dstng, src.boxArray(), src.IndexArray(), srcng,
+		    period, dba_dst, dba_src);
 	}
     }
+
+    if (found)
+    {
+	++(found->m_nuse);
+	m_CPC_stats.recordUse();
+	return *found;
+    }
     
     // Have to build a new one
     CPC* new_cpc = new CPC(*this, dstng, src, srcng, period);
@@ -629,17 +850,30 @@ FabArrayBase::FB::FB (const FabArrayBase& fa, const IntVect& nghost,
 {
     BL_PROFILE("FabArrayBase::FB::FB()");
 
+    {
+        PlanHash ph;
+        ph.add(0x4642ULL); // "FB"
+        ph.add(fa.boxArray());
+        ph.add(fa.DistributionMap());
+        ph.add(nghost);
+        ph.add(static_cast<ULong>(cross));
+        ph.add(static_cast<ULong>(enforce_periodicity_only));
+        ph.add(period);
+        m_plan_id = ph.h;
+    }
+
     m_LocTags.reset(new CopyComTag::CopyComTagsContainer);
     m_SndTags.reset(new CopyComTag::MapOfCopyComTagContainers);
     m_RcvTags.reset(new CopyComTag::MapOfCopyComTagContainers);
 
-    if (!fa.IndexArray().empty()) {
-	if (enforce_periodicity_only) {
-	    BL_ASSERT(m_cross==false);
-	    define_epo(fa);
-	} else {
-	    define_fb(fa);
-	}
+    if (enforce_periodicity_only) {
+        BL_ASSERT(m_cross==false);
+        if (!fa.IndexArray().empty()) {
+            define_epo(fa);
+        }
+    } else if (!fa.IndexArray().empty() || FabArrayBase::use_rendezvous) {
+        // The rendezvous is collective.
+        define_fb(fa);
     }
 }
 
@@ -657,32 +891,64 @@ FabArrayBase::FB::define_fb(const FabArrayBase& fa)
     const int nlocal = imap.size();
     const IntVect& ng = m_ngrow;
     std::vector< std::pair<int,Box> > isects;
+    Vector<int> isects_offset;
+    Vector<Box> query;
     
     const std::vector<IntVect>& pshifts = m_period.shiftIntVect();
+    const int nshifts = pshifts.size();
+
+    // With the rendezvous, only the local boxes and their neighbors are used.
+    std::unique_ptr<DistributedBoxArray> dba;
+    if (FabArrayBase::use_rendezvous)
+    {
+        dba.reset(new DistributedBoxArray(fbHalo(ba, imap, ng, m_period)));
+    }
+
+    auto box_of   = [&] (int k) { return (dba) ? dba->haloBox(k)   : ba[k]; };
+    auto owner_of = [&] (int k) { return (dba) ? dba->haloOwner(k) : dm[k]; };
+    auto find_isects = [&] (const IntVect& ngrow)
+    {
+        if (dba) {
+            dba->intersections(query, isects_offset, isects, ngrow);
+        } else {
+            ba.intersections(query, isects_offset, isects, ngrow);
+        }
+    };
     
     auto& send_tags = *m_SndTags;
+
+    query.reserve(nlocal*nshifts);
+    for (int i = 0; i < nlocal; ++i)
+    {
+        const Box& vbx = ba[imap[i]];
+        for (const auto& iv : pshifts) {
+            query.push_back(vbx+iv);
+        }
+    }
+
+    find_isects(ng);
     
     for (int i = 0; i < nlocal; ++i)
     {
 	const int ksnd = imap[i];
-	const Box& vbx = ba[ksnd];
 	
-	for (auto pit=pshifts.cbegin(); pit!=pshifts.cend(); ++pit)
+	for (int ishift = 0; ishift < nshifts; ++ishift)
 	{
-	    ba.intersections(vbx+(*pit), isects, false, ng);
+            const IntVect& shift = pshifts[ishift];
+            const int iq = i*nshifts + ishift;
 
-	    for (int j = 0, M = isects.size(); j < M; ++j)
+	    for (int j = isects_offset[iq], M = isects_offset[iq+1]; j < M; ++j)
 	    {
 		const int krcv      = isects[j].first;
 		const Box& bx       = isects[j].second;
-		const int dst_owner = dm[krcv];
+		const int dst_owner = owner_of(krcv);
 		
 		if (ParallelDescriptor::sameTeam(dst_owner)) {
 		    continue;  // local copy will be dealt with later
 		} else if (MyProc == dm[ksnd]) {
-		    const BoxList& bl = amrex::boxDiff(bx, ba[krcv]);
+		    const BoxList& bl = amrex::boxDiff(bx, box_of(krcv));
 		    for (BoxList::const_iterator lit = bl.begin(); lit != bl.end(); ++lit)
-			send_tags[dst_owner].push_back(CopyComTag(*lit, (*lit)-(*pit), krcv, ksnd));
+			send_tags[dst_owner].push_back(CopyComTag(*lit, (*lit)-shift, krcv, ksnd));
 		}
 	    }
 	}
@@ -709,6 +975,17 @@ FabArrayBase::FB::define_fb(const FabArrayBase& fa)
     m_threadsafe_loc = not check_local;
     m_threadsafe_rcv = not check_remote;
 
+    query.clear();
+    for (int i = 0; i < nlocal; ++i)
+    {
+        const Box& bxrcv = amrex::grow(ba[imap[i]], ng);
+        for (const auto& iv : pshifts) {
+            query.push_back(bxrcv+iv);
+        }
+    }
+
+    find_isects(IntVect::TheZeroVector());
+
     for (int i = 0; i < nlocal; ++i)
     {
 	const int   krcv = imap[i];
@@ -725,15 +1002,16 @@ FabArrayBase::FB::define_fb(const FabArrayBase& fa)
 	    remotetouch.setVal<RunOn::Host>(0);
 	}
 	
-	for (auto pit=pshifts.cbegin(); pit!=pshifts.cend(); ++pit)
+	for (int ishift = 0; ishift < nshifts; ++ishift)
 	{
-	    ba.intersections(bxrcv+(*pit), isects);
+            const IntVect& shift = pshifts[ishift];
+            const int iq = i*nshifts + ishift;
 
-	    for (int j = 0, M = isects.size(); j < M; ++j)
+	    for (int j = isects_offset[iq], M = isects_offset[iq+1]; j < M; ++j)
 	    {
 		const int ksnd      = isects[j].first;
-		const Box& dst_bx   = isects[j].second - *pit;
-		const int src_owner = dm[ksnd];
+		const Box& dst_bx   = isects[j].second - shift;
+		const int src_owner = owner_of(ksnd);
 		
 		const BoxList& bl = amrex::boxDiff(dst_bx, vbx);
 		for (BoxList::const_iterator lit = bl.begin(); lit != bl.end(); ++lit)
@@ -746,13 +1024,13 @@ FabArrayBase::FB::define_fb(const FabArrayBase& fa)
 				 it_tile  = tilelist.begin(),
 				 End_tile = tilelist.end();   it_tile != End_tile; ++it_tile)
 			{
-			    m_LocTags->push_back(CopyComTag(*it_tile, (*it_tile)+(*pit), krcv, ksnd));
+			    m_LocTags->push_back(CopyComTag(*it_tile, (*it_tile)+shift, krcv, ksnd));
 			}
 			if (check_local) {
 			    localtouch.plus<RunOn::Host>(1, blbx);
 			}
 		    } else if (MyProc == dm[krcv]) {
-			recv_tags[src_owner].push_back(CopyComTag(blbx, blbx+(*pit), krcv, ksnd));
+			recv_tags[src_owner].push_back(CopyComTag(blbx, blbx+shift, krcv, ksnd));
 			if (check_remote) {
 			    remotetouch.plus<RunOn::Host>(1, blbx);
 			}
@@ -795,7 +1073,7 @@ FabArrayBase::FB::define_fb(const FabArrayBase& fa)
 
 		std::vector<Box> boxes;
 		if (m_cross) {
-		    const Box& dstvbx = ba[tag.dstIndex];
+		    const Box& dstvbx = box_of(tag.dstIndex);
 		    for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
 		    {
 			Box lo = dstvbx;
@@ -1005,7 +1283,9 @@ FabArrayBase::FB::define_epo (const FabArrayBase& fa)
 }
 
 FabArrayBase::FB::~FB ()
-{}
+{
+    recordCommPattern("FB", *this);
+}
 
 void
 FabArrayBase::flushFB (bool no_assertion) const
@@ -1045,6 +1325,7 @@ FabArrayBase::getFB (const IntVect& nghost, const Periodicity& period,
 
     BL_ASSERT(getBDKey() == m_bdkey);
     std::pair<FBCacheIter,FBCacheIter> er_it = m_TheFBCache.equal_range(m_bdkey);
+    FB* found = nullptr;
     for (FBCacheIter it = er_it.first; it != er_it.second; ++it)
     {
 	if (it->second->m_typ        == boxArray().ixType()      &&
@@ -1054,12 +1335,26 @@ FabArrayBase::getFB (const IntVect& nghost, const Periodicity& period,
 	    it->second->m_epo        == enforce_periodicity_only &&
 	    it->second->m_period     == period              )
 	{
-	    ++(it->second->m_nuse);
-	    m_FBC_stats.recordUse();
-	    return *(it->second);
+	    found = it->second;
+	    break;
+	}
+    }
+
+    // Only define_fb uses the rendezvous.
+    if (FabArrayBase::use_rendezvous && !enforce_periodicity_only)
+    {
+	if (anyBuilds(found != nullptr) && found) {
+	    fbHalo(boxArray(), IndexArray(), nghost, period);
 	}
     }
 
+    if (found)
+    {
+	++(found->m_nuse);
+	m_FBC_stats.recordUse();
+	return *found;
+    }
+
     // Have to build a new one
     FB* new_fb = new FB(*this, nghost, cross, period, enforce_periodicity_only);
 
@@ -1387,6 +1682,119 @@ FabArrayBase::flushCFinfo (bool no_assertion)
     m_TheCrseFineCache.erase(er_it.first, er_it.second);
 }
 
+void
+FabArrayBase::WriteCommPattern (const std::string& filename)
+{
+    BL_PROFILE("FabArrayBase::WriteCommPattern()");
+
+    AMREX_ALWAYS_ASSERT(comm_pattern_profiling);
+
+    // Fold in the plans that are still cached.  A CPC may appear twice.
+    for (auto const& kv : m_TheFBCache) {
+        recordCommPattern("FB", *kv.second);
+    }
+    for (auto const& kv : m_TheCPCache) {
+        recordCommPattern("CPC", *kv.second);
+    }
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int ioproc = ParallelDescriptor::IOProcessorNumber();
+
+    // Processes on the same node share memory.  Use the lowest rank on a node as its id.
+    int node = ParallelDescriptor::MyProc();
+#ifdef BL_USE_MPI
+    {
+        MPI_Comm node_comm;
+        MPI_Comm_split_type(ParallelDescriptor::Communicator(), MPI_COMM_TYPE_SHARED,
+                            ParallelDescriptor::MyProc(), MPI_INFO_NULL, &node_comm);
+        MPI_Allreduce(MPI_IN_PLACE, &node, 1, MPI_INT, MPI_MIN, node_comm);
+        MPI_Comm_free(&node_comm);
+    }
+#endif
+    Vector<int> nodes(nprocs);
+    ParallelDescriptor::Gather(&node, 1, nodes.data(), 1, ioproc);
+
+    // [id, ncomm, nentries, (dst, bytes, msgs)*]*
+    Vector<Long> local;
+    for (auto const& kv : comm_patterns) {
+        local.push_back(static_cast<Long>(kv.first));
+        local.push_back(kv.second.ncomm);
+        local.push_back(kv.second.to.size());
+        for (auto const& e : kv.second.to) {
+            local.push_back(e.first);
+            local.push_back(e.second.first);
+            local.push_back(e.second.second);
+        }
+    }
+
+    int nlocal = local.size();
+    Vector<int> counts(nprocs);
+    ParallelDescriptor::Gather(&nlocal, 1, counts.data(), 1, ioproc);
+
+    Vector<Long> all;
+#ifdef BL_USE_MPI
+    std::vector<int> rc(counts.begin(), counts.end());
+    std::vector<int> disp(nprocs, 0);
+    if (ParallelDescriptor::MyProc() == ioproc) {
+        for (int i = 1; i < nprocs; ++i) disp[i] = disp[i-1] + rc[i-1];
+        all.resize(disp[nprocs-1] + rc[nprocs-1]);
+    }
+    ParallelDescriptor::Gatherv(local.data(), nlocal, all.data(), rc, disp, ioproc);
+#else
+    all = local;
+#endif
+
+    if (ParallelDescriptor::MyProc() != ioproc) return;
+
+    struct PlanSummary {
+        Long ncomm = 0;
+        Long bytes[2] = {0,0}; // on-node, off-node
+        Long msgs[2] = {0,0};
+    };
+    std::map<ULong,PlanSummary> summary;
+    std::ostringstream msgs;
+
+    Long offset = 0;
+    for (int src = 0; src < nprocs; ++src) {
+        const Long end = offset + counts[src];
+        while (offset < end) {
+            const ULong id = static_cast<ULong>(all[offset++]);
+            PlanSummary& ps = summary[id];
+            ps.ncomm = std::max(ps.ncomm, all[offset++]);
+            const Long nentries = all[offset++];
+            for (Long n = 0; n < nentries; ++n) {
+                const int dst = static_cast<int>(all[offset++]);
+                const Long bytes = all[offset++];
+                const Long nmsgs = all[offset++];
+                const int off_node = (nodes[src] == nodes[dst]) ? 0 : 1;
+                ps.bytes[off_node] += bytes;
+                if (src != dst) ps.msgs[off_node] += nmsgs;
+                msgs << "msg " << id << " " << src << " " << dst << " "
+                     << bytes << " " << nmsgs << "\n";
+            }
+        }
+    }
+
+    std::ofstream ofs(filename);
+    if (!ofs.good()) amrex::FileOpenFailed(filename);
+
+    ofs << "# AMReX communication pattern\n"
+        << "nprocs " << nprocs << "\n";
+    for (int i = 0; i < nprocs; ++i) {
+        ofs << "rank " << i << " " << nodes[i] << "\n";
+    }
+    for (auto const& kv : summary) {
+        auto found = comm_patterns.find(kv.first);
+        const std::string kind = (found != comm_patterns.end()) ? found->second.kind : "-";
+        const std::string tag  = (found != comm_patterns.end()) ? found->second.tag  : "-";
+        ofs << "plan " << kv.first << " " << kind << " " << tag << " "
+            << kv.second.ncomm << " "
+            << kv.second.bytes[0] << " " << kv.second.bytes[1] << " "
+            << kv.second.msgs[0] << " " << kv.second.msgs[1] << "\n";
+    }
+    ofs << msgs.str();
+}
+
 void
 FabArrayBase::Finalize ()
 {
@@ -1394,6 +1802,15 @@ FabArrayBase::Finalize ()
     FabArrayBase::flushCPCache();
     FabArrayBase::flushTileArrayCache();
 
+    if (comm_pattern_profiling) {
+        std::string filename;
+        ParmParse pp("fabarray");
+        if (pp.query("comm_pattern_file", filename)) {
+            WriteCommPattern(filename);
+        }
+        comm_patterns.clear();
+    }
+
     if (ParallelDescriptor::IOProcessor() && amrex::system::verbose > 1) {
 	m_FA_stats.print();
 	m_TAC_stats.print();
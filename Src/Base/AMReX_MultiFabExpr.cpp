@@ -0,0 +1,94 @@
+
+#include <AMReX_MultiFabExpr.H>
+#include <AMReX.H>
+#include <AMReX_ParallelDescriptor.H>
+
+namespace amrex {
+namespace MFExpr {
+namespace detail {
+
+void
+Combine (Real* r, Real const* v, ReduceKind const* kind, int n) noexcept
+{
+    for (int i = 0; i < n; ++i) {
+        switch (kind[i]) {
+        case ReduceKind::max: r[i] = std::max(r[i], v[i]); break;
+        case ReduceKind::min: r[i] = std::min(r[i], v[i]); break;
+        default:              r[i] += v[i];
+        }
+    }
+}
+
+#ifdef BL_USE_MPI
+
+namespace {
+
+    MPI_Op mixed_op = MPI_OP_NULL;
+
+    // The buffer is a single element of a contiguous type made of n values
+    // followed by their n kinds, so that MPI cannot split it.
+    void mixed_reduce (void* a_in, void* a_inout, int* len, MPI_Datatype* dtype)
+    {
+        int nbytes;
+        MPI_Type_size(*dtype, &nbytes);
+        const int n = nbytes/sizeof(Real)/2;
+        Real const* in = static_cast<Real const*>(a_in);
+        Real* inout = static_cast<Real*>(a_inout);
+        Vector<ReduceKind> kind(n);
+        for (int e = 0; e < *len; ++e) {
+            for (int i = 0; i < n; ++i) {
+                kind[i] = static_cast<ReduceKind>(static_cast<int>(inout[n+i]));
+            }
+            Combine(inout, in, kind.data(), n);
+            in    += 2*n;
+            inout += 2*n;
+        }
+    }
+
+    void free_mixed_op ()
+    {
+        if (mixed_op != MPI_OP_NULL) {
+            MPI_Op_free(&mixed_op);
+            mixed_op = MPI_OP_NULL;
+        }
+    }
+}
+
+#endif
+
+void
+AllReduce (Real* v, ReduceKind const* kind, int n, MPI_Comm comm)
+{
+#ifdef BL_USE_MPI
+    int nprocs;
+    MPI_Comm_size(comm, &nprocs);
+    if (nprocs == 1) return;
+
+    BL_PROFILE("MFExpr::AllReduce()");
+
+    if (mixed_op == MPI_OP_NULL) {
+        MPI_Op_create(&mixed_reduce, 1, &mixed_op);
+        amrex::ExecOnFinalize(free_mixed_op);
+    }
+
+    Vector<Real> buf(2*n);
+    for (int i = 0; i < n; ++i) {
+        buf[i] = v[i];
+        buf[n+i] = static_cast<Real>(static_cast<int>(kind[i]));
+    }
+
+    MPI_Datatype dtype;
+    MPI_Type_contiguous(2*n, ParallelDescriptor::Mpi_typemap<Real>::type(), &dtype);
+    MPI_Type_commit(&dtype);
+    MPI_Allreduce(MPI_IN_PLACE, buf.data(), 1, dtype, mixed_op, comm);
+    MPI_Type_free(&dtype);
+
+    for (int i = 0; i < n; ++i) {
+        v[i] = buf[i];
+    }
+#else
+    amrex::ignore_unused(v,kind,n,comm);
+#endif
+}
+
+}}}
@@ -655,11 +655,27 @@ namespace amrex
 
         const BoxArray& cfba = amrex::coarsen(fba,ratio);
         const std::vector<IntVect>& pshifts = period.shiftIntVect();
+        const int nshifts = pshifts.size();
+
+        const Vector<int>& imap = mask.IndexArray();
+        const int nlocal = imap.size();
+        Vector<Box> query;
+        query.reserve(nlocal*nshifts);
+        for (int li = 0; li < nlocal; ++li) {
+            const Box& bx = mask.fabbox(imap[li]);
+            for (const auto& iv : pshifts) {
+                query.push_back(bx+iv);
+            }
+        }
+
+        Vector<int> isects_offset;
+        std::vector <std::pair<int,Box> > isects;
+        cfba.intersections(query, isects_offset, isects);
+
 #ifdef _OPENMP
 #pragma omp parallel if (!run_on_gpu)
 #endif
         {
-            std::vector <std::pair<int,Box> > isects;
             for (MFIter mfi(mask); mfi.isValid(); ++mfi)
             {
                 const Box& bx = mfi.fabbox();
@@ -671,10 +687,10 @@ namespace amrex
                     arr(i,j,k) = crse_value;
                 });
 
-                for (const auto& iv : pshifts) {
-                    cfba.intersections(bx+iv, isects);
-                    for (const auto& is : isects) {
-                        Box const& b = is.second-iv;
+                for (int ishift = 0; ishift < nshifts; ++ishift) {
+                    const int iq = mfi.LocalIndex()*nshifts + ishift;
+                    for (int j = isects_offset[iq]; j < isects_offset[iq+1]; ++j) {
+                        Box const& b = isects[j].second-pshifts[ishift];
                         if (run_on_gpu) {
                             tags.push_back({arr,b});
                         } else {
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <limits>
 #include <AMReX_PlotFileDataImpl.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_VisMF.H>
@@ -94,6 +95,30 @@ PlotFileDataImpl::PlotFileDataImpl (std::string const& plotfile_name)
             m_ngrow[ilev] = m_vismf[ilev]->nGrowVect();
         }
     }
+
+    // Optional multi-resolution pyramid
+    m_pyr_mf_name.resize(m_nlevels);
+    m_pyr_vismf.resize(m_nlevels);
+    Vector<char> pyrCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(plotfile_name+"/Pyramid", pyrCharPtr, false);
+    if (!pyrCharPtr.empty()) {
+        std::istringstream pis(std::string(pyrCharPtr.dataPtr()), std::istringstream::in);
+        std::string pyr_version;
+        int nlevs;
+        pis >> pyr_version >> nlevs;
+        for (int ilev = 0; ilev < std::min(nlevs,m_nlevels); ++ilev) {
+            int levtmp, depth;
+            pis >> levtmp >> depth;
+            for (int d = 1; d <= depth; ++d) {
+                int dtmp;
+                Box domain;
+                std::string relname;
+                pis >> dtmp >> domain >> relname;
+                m_pyr_mf_name[ilev].push_back(m_plotfile_name + "/" + relname);
+            }
+            m_pyr_vismf[ilev].resize(depth);
+        }
+    }
 }
 
 PlotFileDataImpl::~PlotFileDataImpl () {}
@@ -142,4 +167,129 @@ PlotFileDataImpl::get (int level, std::string const& varname) noexcept
     return mf;
 }
 
+int
+PlotFileDataImpl::varIndex (std::string const& varname) const noexcept
+{
+    auto r = std::find(std::begin(m_var_names), std::end(m_var_names), varname);
+    if (r == std::end(m_var_names)) {
+        amrex::Abort("PlotFileDataImpl: varname not found "+varname);
+    }
+    return std::distance(std::begin(m_var_names), r);
+}
+
+std::unique_ptr<FArrayBox>
+PlotFileDataImpl::getFab (int level, int gid, std::string const& varname) noexcept
+{
+    return std::unique_ptr<FArrayBox>(m_vismf[level]->readFAB(gid, varIndex(varname)));
+}
+
+std::unique_ptr<FArrayBox>
+PlotFileDataImpl::getFab (int level, int gid, std::string const& varname, Box const& region) noexcept
+{
+    return std::unique_ptr<FArrayBox>(m_vismf[level]->readFAB(gid, region, varIndex(varname), 1));
+}
+
+MultiFab
+PlotFileDataImpl::get (int level, std::string const& varname, Box const& region) noexcept
+{
+    int icomp = varIndex(varname);
+
+    // Clip region first so that it can be given with unbounded extents.
+    const Box rbx = region & m_ba[level].minimalBox();
+    BoxList bl(region.ixType());
+    Vector<int> src_index;
+    if (rbx.ok()) {
+        for (auto const& is : m_ba[level].intersections(rbx)) {
+            bl.push_back(is.second);
+            src_index.push_back(is.first);
+        }
+    }
+
+    MultiFab mf;
+    if (bl.isEmpty()) return mf;
+
+    BoxArray ba(std::move(bl));
+    DistributionMapping dm(ba);
+    mf.define(ba, dm, 1, 0);
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        int gid = src_index[mfi.index()];
+        std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, mfi.validbox(), icomp, 1));
+        mf[mfi].copy<RunOn::Host>(*srcfab);
+    }
+    return mf;
+}
+
+int
+PlotFileDataImpl::findPyramidDepth (int level, int target_size) const noexcept
+{
+    int depth = 0;
+    while (depth < pyramidDepth(level) and pyramidDomain(level,depth+1).longside() >= target_size) {
+        ++depth;
+    }
+    return depth;
+}
+
+const BoxArray&
+PlotFileDataImpl::pyramidBoxArray (int level, int depth) noexcept
+{
+    if (depth == 0) return m_ba[level];
+    AMREX_ALWAYS_ASSERT(depth > 0 and depth <= pyramidDepth(level));
+    auto& vismf = m_pyr_vismf[level][depth-1];
+    if (vismf == nullptr) {
+        vismf.reset(new VisMF(m_pyr_mf_name[level][depth-1]));
+    }
+    return vismf->boxArray();
+}
+
+MultiFab
+PlotFileDataImpl::getCoarsened (int level, int depth, std::string const& varname) noexcept
+{
+    if (depth == 0) return get(level, varname);
+
+    int icomp = varIndex(varname);
+
+    const BoxArray& ba = pyramidBoxArray(level, depth);
+    VisMF& vismf = *m_pyr_vismf[level][depth-1];
+    MultiFab mf(ba, DistributionMapping{ba}, 1, 0);
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        std::unique_ptr<FArrayBox> srcfab(vismf.readFAB(mfi.index(), icomp));
+        mf[mfi].copy<RunOn::Host>(*srcfab);
+    }
+    return mf;
+}
+
+Real
+PlotFileDataImpl::min (int level, std::string const& varname) noexcept
+{
+    int icomp = varIndex(varname);
+
+    const VisMF& vismf = *m_vismf[level];
+    constexpr Real none = std::numeric_limits<Real>::max();
+    if (vismf.size() == 0 or vismf.min(0,icomp) == none) { // not in the header
+        return get(level, varname).min(0);
+    }
+    Real mn = none;
+    for (int i = 0, N = vismf.size(); i < N; ++i) {
+        mn = std::min(mn, vismf.min(i,icomp));
+    }
+    return mn;
+}
+
+Real
+PlotFileDataImpl::max (int level, std::string const& varname) noexcept
+{
+    int icomp = varIndex(varname);
+
+    const VisMF& vismf = *m_vismf[level];
+    constexpr Real none = std::numeric_limits<Real>::lowest();
+    if (vismf.size() == 0 or vismf.max(0,icomp) == none) { // not in the header
+        return get(level, varname).max(0);
+    }
+    Real mx = none;
+    for (int i = 0, N = vismf.size(); i < N; ++i) {
+        mx = std::max(mx, vismf.max(i,icomp));
+    }
+    return mx;
+}
+
 }
@@ -5,6 +5,8 @@
 #include <AMReX_VisMF.H>
 #include <AMReX_AsyncOut.H>
 #include <AMReX_PlotFileUtil.H>
+#include <AMReX_MultiFabUtil.H>
+#include <AMReX_ParmParse.H>
 
 #ifdef AMREX_USE_EB
 #include <AMReX_EBFabFactory.H>
@@ -58,6 +60,50 @@ std::string MultiFabFileFullPrefix (int level,
     return r;
 }
 
+namespace {
+    int  s_pyramid_size = 0;
+    bool s_pyramid_initialized = false;
+
+    // Number of coarsened copies of a level in the pyramid
+    int PyramidDepth (BoxArray ba, Box domain, int min_size)
+    {
+        int depth = 0;
+        if (min_size > 0) {
+            while (ba.coarsenable(2) and amrex::coarsen(domain,2).longside() >= min_size) {
+                ba.coarsen(2);
+                domain.coarsen(2);
+                ++depth;
+            }
+        }
+        return depth;
+    }
+}
+
+void SetPlotfilePyramidSize (int min_size)
+{
+    s_pyramid_size = min_size;
+    s_pyramid_initialized = true;
+}
+
+int PlotfilePyramidSize ()
+{
+    if (!s_pyramid_initialized) {
+        ParmParse pp("amrex");
+        pp.query("plotfile_pyramid_size", s_pyramid_size);
+        s_pyramid_initialized = true;
+        amrex::ExecOnFinalize([] () { s_pyramid_size = 0; s_pyramid_initialized = false; });
+    }
+    return s_pyramid_size;
+}
+
+std::string PyramidMultiFabPath (int level, int depth,
+                                 const std::string &levelPrefix,
+                                 const std::string &mfPrefix)
+{
+    // e.g., Level_4/Cell_r8
+    return MultiFabHeaderPath(level, levelPrefix, mfPrefix) + "_r" + std::to_string(1 << depth);
+}
+
 
 void
 PreBuildDirectorHierarchy (const std::string &dirName,
@@ -190,6 +236,13 @@ WriteMultiLevelPlotfile (const std::string& plotfilename, int nlevels,
     }
     ParallelDescriptor::Barrier();
 
+    const int pyramid_size = PlotfilePyramidSize();
+    Vector<int> pyramid_depth(nlevels);
+    for (int level = 0; level <= finest_level; ++level) {
+        pyramid_depth[level] = PyramidDepth(mf[level]->boxArray(), geom[level].Domain(),
+                                            pyramid_size);
+    }
+
     if (ParallelDescriptor::MyProc() == ParallelDescriptor::NProcs()-1) {
         Vector<BoxArray> boxArrays(nlevels);
         for(int level(0); level < boxArrays.size(); ++level) {
@@ -208,6 +261,23 @@ WriteMultiLevelPlotfile (const std::string& plotfilename, int nlevels,
             WriteGenericPlotfileHeader(HeaderFile, nlevels, boxArrays, varnames,
                                        geom, time, level_steps, ref_ratio, versionName,
                                        levelPrefix, mfPrefix);
+
+            if (pyramid_size > 0) {
+                std::string PyramidFileName(plotfilename + "/Pyramid");
+                std::ofstream PyramidFile(PyramidFileName.c_str(), std::ofstream::out   |
+                                                                   std::ofstream::trunc |
+                                                                   std::ofstream::binary);
+                if( ! PyramidFile.good()) FileOpenFailed(PyramidFileName);
+                PyramidFile << "Pyramid-V1\n" << nlevels << '\n';
+                for (int level = 0; level < nlevels; ++level) {
+                    PyramidFile << level << ' ' << pyramid_depth[level] << '\n';
+                    for (int d = 1; d <= pyramid_depth[level]; ++d) {
+                        PyramidFile << d << ' ' << amrex::coarsen(geom[level].Domain(), 1 << d)
+                                    << ' ' << PyramidMultiFabPath(level, d, levelPrefix, mfPrefix)
+                                    << '\n';
+                    }
+                }
+            }
         };
 
         if (AsyncOut::UseAsyncOut()) {
@@ -238,6 +308,28 @@ WriteMultiLevelPlotfile (const std::string& plotfilename, int nlevels,
             }
             VisMF::Write(*data, MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mfPrefix));
         }
+
+        // Coarsened copies of the level, each averaged down from the previous one
+        std::string pyramid_prefix(plotfilename);
+        if (pyramid_prefix.back() != '/') pyramid_prefix += '/';
+        const int ncomp = mf[level]->nComp();
+        const MultiFab* fine = mf[level];
+        MultiFab crse;
+        Geometry fine_geom = geom[level];
+        for (int d = 1; d <= pyramid_depth[level]; ++d) {
+            const Geometry crse_geom = amrex::coarsen(fine_geom, 2);
+            MultiFab tmp(amrex::coarsen(fine->boxArray(),2), fine->DistributionMap(), ncomp, 0);
+            amrex::average_down(*fine, tmp, fine_geom, crse_geom, 0, ncomp, 2);
+            const std::string name = pyramid_prefix + PyramidMultiFabPath(level, d, levelPrefix, mfPrefix);
+            if (AsyncOut::UseAsyncOut()) {
+                VisMF::AsyncWrite(tmp, name);
+            } else {
+                VisMF::Write(tmp, name);
+            }
+            crse = std::move(tmp);
+            fine = &crse;
+            fine_geom = crse_geom;
+        }
     }
 }
 
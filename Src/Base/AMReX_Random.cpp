@@ -9,6 +9,8 @@
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuDevice.H>
 #include <AMReX_OpenMP.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_BLProfiler.H>
 
 #ifdef AMREX_USE_HIP
 #include <hiprand.hpp>
@@ -443,6 +445,62 @@ amrex::NItemsPerBin (int totalItems, Vector<int> &binCounts)
   }
 }
 
+void
+amrex::FillRandom (MultiFab& mf, int dcomp, int ncomp, ULong seed, unsigned int step, int nghost)
+{
+    BL_PROFILE("amrex::FillRandom()");
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+        Array4<Real> const& a = mf.array(mfi,dcomp);
+        amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            a(i,j,k,n) = RandomUniform(seed, RandomCellId(i,j,k), step, n);
+        });
+    }
+}
+
+void
+amrex::FillRandomNormal (MultiFab& mf, int dcomp, int ncomp, Real mean, Real stddev,
+                         ULong seed, unsigned int step, int nghost)
+{
+    BL_PROFILE("amrex::FillRandomNormal()");
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+        Array4<Real> const& a = mf.array(mfi,dcomp);
+        amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            a(i,j,k,n) = RandomNormal(mean, stddev, seed, RandomCellId(i,j,k), step, n);
+        });
+    }
+}
+
+void
+amrex::FillRandom (Real* a, const ULong* ids, Long n, ULong seed, unsigned int step,
+                   unsigned int stream)
+{
+    amrex::ParallelFor(n, [=] AMREX_GPU_DEVICE (Long i) noexcept
+    {
+        a[i] = RandomUniform(seed, ids[i], step, stream);
+    });
+}
+
+void
+amrex::FillRandomNormal (Real* a, const ULong* ids, Long n, Real mean, Real stddev,
+                         ULong seed, unsigned int step, unsigned int stream)
+{
+    amrex::ParallelFor(n, [=] AMREX_GPU_DEVICE (Long i) noexcept
+    {
+        a[i] = RandomNormal(mean, stddev, seed, ids[i], step, stream);
+    });
+}
 
 //
 // Fortran entry points for amrex::Random().
@@ -5,6 +5,8 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <set>
 
 #include <AMReX_TinyProfiler.H>
@@ -12,49 +14,167 @@
 #include <AMReX_ParallelReduce.H>
 #include <AMReX_Utility.H>
 #include <AMReX_Print.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_ParmParse.H>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #ifdef AMREX_USE_CUPTI
 #include <AMReX_CuptiTrace.H>
 #include <cupti.h>
 #endif
 
-#ifdef _OPENMP
-#include <omp.h>
-#endif
-
-
 namespace amrex {
 
-std::vector<std::string>          TinyProfiler::regionstack;
-std::deque<std::tuple<double,double,std::string*> > TinyProfiler::ttstack;
-std::map<std::string,std::map<std::string, TinyProfiler::Stats> > TinyProfiler::statsmap;
+std::vector<int>                  TinyProfiler::regionstack;
+std::vector<std::string>          TinyProfiler::regionnames;
+std::vector<TinyProfiler::ThreadState> TinyProfiler::tstates;
 double TinyProfiler::t_init = std::numeric_limits<double>::max();
+bool TinyProfiler::hw_counters = false;
+bool TinyProfiler::hw_finalized = false;
+constexpr int TinyProfiler::NHWCounters;
+std::deque<TinyProfiler::TimerName> TinyProfiler::timernames;
+std::unordered_map<std::string,int> TinyProfiler::timerids;
 
 namespace {
     std::set<std::string> improperly_nested_timers;
     static constexpr char mainregion[] = "main";
+    // bytes moved from memory per last-level cache miss
+    static constexpr double cache_line_bytes = 64.;
+}
+
+void
+TinyProfiler::OpenHWCounters (ThreadState& ts) noexcept
+{
+    ts.hwinit = true;
+#if defined(__linux__)
+    const unsigned long long config[NHWCounters] = {PERF_COUNT_HW_CPU_CYCLES,
+                                                    PERF_COUNT_HW_INSTRUCTIONS,
+                                                    PERF_COUNT_HW_CACHE_MISSES};
+    for (int i = 0; i < NHWCounters; ++i)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config[i];
+        attr.disabled = (i == 0) ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        // measure the calling thread on any cpu
+        const int leader = (i == 0) ? -1 : ts.hwfd[0];
+        int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+        if (fd < 0) {
+            CloseHWCounters(ts);
+            ts.hwinit = true;
+            return;
+        }
+        ts.hwfd[ts.nhwfd++] = fd;
+    }
+    ioctl(ts.hwfd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(ts.hwfd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void
+TinyProfiler::CloseHWCounters (ThreadState& ts) noexcept
+{
+#if defined(__linux__)
+    for (int i = ts.nhwfd-1; i >= 0; --i) {
+        close(ts.hwfd[i]);
+    }
+#endif
+    ts.nhwfd = 0;
+    ts.hwinit = false;
+}
+
+void
+TinyProfiler::ReadHWCounters (ThreadState const& ts, Long* counts) noexcept
+{
+    for (int i = 0; i < NHWCounters; ++i) counts[i] = 0;
+#if defined(__linux__)
+    if (ts.nhwfd == NHWCounters) {
+        // with PERF_FORMAT_GROUP: number of events followed by the values
+        std::uint64_t buf[1+NHWCounters];
+        if (read(ts.hwfd[0], buf, sizeof(buf)) == static_cast<ssize_t>(sizeof(buf))) {
+            for (int i = 0; i < NHWCounters; ++i) counts[i] = static_cast<Long>(buf[1+i]);
+        }
+    }
+#endif
+}
+
+TinyProfiler::TimerName const*
+TinyProfiler::GetTimer (const std::string& name) noexcept
+{
+    TimerName const* r = nullptr;
+#ifdef _OPENMP
+#pragma omp critical(tinyprofiler_timernames)
+#endif
+    {
+        auto found = timerids.find(name);
+        if (found != timerids.end()) {
+            r = &timernames[found->second];
+        } else {
+            int id = timernames.size();
+            timernames.emplace_back(name, id);
+            timerids.insert(std::make_pair(name, id));
+            r = &timernames.back();
+        }
+    }
+    return r;
+}
+
+TinyProfiler::TimerName const*
+TinyProfiler::GetTimer (const char* name, CallSite& site) noexcept
+{
+    // The name of a call site is almost always a string literal, but it
+    // is checked anyway so that a site with a varying name stays correct.
+    TimerName const* r = site.entry.load(std::memory_order_acquire);
+    if (r == nullptr || std::strcmp(r->name.c_str(), name) != 0) {
+        r = GetTimer(std::string(name));
+        site.entry.store(r, std::memory_order_release);
+    }
+    return r;
 }
 
 TinyProfiler::TinyProfiler (std::string funcname) noexcept
-    : fname(std::move(funcname)), uCUPTI(false)
+    : fname(GetTimer(funcname)), uCUPTI(false)
 {
     start();
 }
 
 TinyProfiler::TinyProfiler (std::string funcname, bool start_, bool useCUPTI) noexcept
-    : fname(std::move(funcname)), uCUPTI(useCUPTI)
+    : fname(GetTimer(funcname)), uCUPTI(useCUPTI)
 {
     if (start_) start();
 }
 
 TinyProfiler::TinyProfiler (const char* funcname) noexcept
-    : fname(funcname), uCUPTI(false)
+    : fname(GetTimer(std::string(funcname))), uCUPTI(false)
 {
     start();
 }
 
 TinyProfiler::TinyProfiler (const char* funcname, bool start_, bool useCUPTI) noexcept
-    : fname(funcname), uCUPTI(useCUPTI)
+    : fname(GetTimer(std::string(funcname))), uCUPTI(useCUPTI)
+{
+    if (start_) start();
+}
+
+TinyProfiler::TinyProfiler (const char* funcname, CallSite& site, bool start_, bool useCUPTI) noexcept
+    : fname(GetTimer(funcname, site)), uCUPTI(useCUPTI)
+{
+    if (start_) start();
+}
+
+TinyProfiler::TinyProfiler (const std::string& funcname, CallSite& /*site*/, bool start_, bool useCUPTI) noexcept
+    : fname(GetTimer(funcname)), uCUPTI(useCUPTI)
 {
     if (start_) start();
 }
@@ -67,12 +187,11 @@ TinyProfiler::~TinyProfiler ()
 void
 TinyProfiler::start () noexcept
 {
-#ifdef _OPENMP
-#pragma omp master
-#endif
-    if (stats.empty() && !regionstack.empty())
+    const int thread = OpenMP::get_thread_num();
+    if (stats.empty() && !regionstack.empty() && thread < static_cast<int>(tstates.size()))
     {
-        double t;
+        tid = thread;
+        double t = 0.0;
 	if (!uCUPTI) {
 	    t = amrex::second();
 	} else {
@@ -84,16 +203,33 @@ TinyProfiler::start () noexcept
 #endif
 	}
 
-	ttstack.emplace_back(std::make_tuple(t, 0.0, &fname));
-	global_depth = ttstack.size();
+        ThreadState& ts = tstates[tid];
+	ts.ttstack.emplace_back(std::make_tuple(t, 0.0, fname));
+	global_depth = ts.ttstack.size();
+
+        if (hw_counters) {
+            if (!ts.hwinit && !hw_finalized) OpenHWCounters(ts);
+            ts.hwstack.emplace_back();
+            HWFrame& hwf = ts.hwstack.back();
+            ReadHWCounters(ts, hwf.start);
+            for (int i = 0; i < NHWCounters; ++i) hwf.child[i] = 0;
+        }
 
 #ifdef AMREX_USE_CUDA
-	nvtx_id = nvtxRangeStartA(fname.c_str());
+	nvtx_id = nvtxRangeStartA(fname->name.c_str());
 #endif
 
-        for (auto const& region : regionstack)
+        const int id = fname->id;
+        for (int region : regionstack)
         {
-            Stats& st = statsmap[region][fname];
+            if (static_cast<int>(ts.stats.size()) <= region) {
+                ts.stats.resize(region+1);
+            }
+            std::deque<Stats>& regstats = ts.stats[region];
+            if (static_cast<int>(regstats.size()) <= id) {
+                regstats.resize(id+1);
+            }
+            Stats& st = regstats[id];
             ++st.depth;
             stats.push_back(&st);
         }
@@ -103,12 +239,9 @@ TinyProfiler::start () noexcept
 void
 TinyProfiler::stop () noexcept
 {
-#ifdef _OPENMP
-#pragma omp master
-#endif
     if (!stats.empty()) 
     {
-        double t;
+        double t = 0.0;
 	int nKernelCalls = 0;
 	if (!uCUPTI) {
 	    t = amrex::second();
@@ -120,55 +253,7 @@ TinyProfiler::stop () noexcept
 	    nKernelCalls = activityRecordUserdata.size();
 #endif
 	}
-
-	while (static_cast<int>(ttstack.size()) > global_depth) {
-	    ttstack.pop_back();
-	};
-
-	if (static_cast<int>(ttstack.size()) == global_depth)
-	{
-	    const std::tuple<double,double,std::string*>& tt = ttstack.back();
-
-	    // first: wall time when the pair is pushed into the stack
-	    // second: accumulated dt of children
-	    double dtin;
-	    double dtex;
-	    if (!uCUPTI) {
-	        dtin = t - std::get<0>(tt); // elapsed time since start() is called.
-	        dtex = dtin - std::get<1>(tt);
-	    } else {
-	        dtin = t;
-	        dtex = dtin - std::get<1>(tt); 
-	    }
-
-        for (Stats* st : stats)
-        {
-            --(st->depth);
-            ++(st->n);
-            if (st->depth == 0) {
-                st->dtin += dtin;
-            }
-            st->dtex += dtex;
-            st->usesCUPTI = uCUPTI;
-            if (uCUPTI) {
-                st->nk += nKernelCalls;
-            }
-        }
-
-        ttstack.pop_back();
-        if (!ttstack.empty()) {
-            std::tuple<double,double,std::string*>& parent = ttstack.back();
-            std::get<1>(parent) += dtin;
-        }
-
-#ifdef AMREX_USE_CUDA
-        nvtxRangeEnd(nvtx_id);
-#endif
-	} else {
-	    improperly_nested_timers.insert(fname);
-	}
-
-    stats.clear();
+        stop_impl(t, nKernelCalls);
     }
 }
 
@@ -176,12 +261,9 @@ TinyProfiler::stop () noexcept
 void
 TinyProfiler::stop (unsigned boxUintID) noexcept
 {
-#ifdef _OPENMP
-#pragma omp master
-#endif
     if (!stats.empty()) 
     {
-        double t;
+        double t = 0.0;
         cudaDeviceSynchronize();
         cuptiActivityFlushAll(0);
         t = computeElapsedTimeUserdata(activityRecordUserdata);
@@ -192,60 +274,115 @@ TinyProfiler::stop (unsigned boxUintID) noexcept
             record->setUintID(boxUintID);
         }
 
-        while (static_cast<int>(ttstack.size()) > global_depth) 
-        {
-            ttstack.pop_back();
-        };
+        stop_impl(t, nKernelCalls);
+    }
+}
+#endif
 
-        if (static_cast<int>(ttstack.size()) == global_depth)
-        {
-            const std::tuple<double,double,std::string*>& tt = ttstack.back();
+void
+TinyProfiler::stop_impl (double t, int nKernelCalls) noexcept
+{
+    ThreadState& ts = tstates[tid];
+    auto& ttstack = ts.ttstack;
+    auto& hwstack = ts.hwstack;
 
-            // first: wall time when the pair is pushed into the stack
-            // second: accumulated dt of children
-            double dtin;
-            double dtex;
+    Long hwin[NHWCounters];
+    if (hw_counters) ReadHWCounters(ts, hwin);
 
+    while (static_cast<int>(ttstack.size()) > global_depth) {
+        ttstack.pop_back();
+        if (hw_counters) hwstack.pop_back();
+    };
+
+    if (static_cast<int>(ttstack.size()) == global_depth)
+    {
+        const std::tuple<double,double,TimerName const*>& tt = ttstack.back();
+
+        // first: wall time when the pair is pushed into the stack
+        // second: accumulated dt of children
+        double dtin;
+        double dtex;
+        if (!uCUPTI) {
+            dtin = t - std::get<0>(tt); // elapsed time since start() is called.
+            dtex = dtin - std::get<1>(tt);
+        } else {
             dtin = t;
             dtex = dtin - std::get<1>(tt); 
+        }
 
-            for (Stats* st : stats)
-            {
-                --(st->depth);
-                ++(st->n);
-                if (st->depth == 0) 
-                {
-                    st->dtin += dtin;
-                }
-                st->dtex += dtex;
-                st->usesCUPTI = uCUPTI;
-                st->nk += nKernelCalls;		
+        Long hwex[NHWCounters];
+        if (hw_counters) {
+            HWFrame const& hwf = hwstack.back();
+            for (int i = 0; i < NHWCounters; ++i) {
+                hwin[i] -= hwf.start[i];
+                hwex[i] = hwin[i] - hwf.child[i];
             }
+        }
 
-            ttstack.pop_back();
-            if (!ttstack.empty()) 
-            {
-                std::tuple<double,double,std::string*>& parent = ttstack.back();
-                std::get<1>(parent) += dtin;
+        for (Stats* st : stats)
+        {
+            --(st->depth);
+            ++(st->n);
+            if (st->depth == 0) {
+                st->dtin += dtin;
             }
+            st->dtex += dtex;
+            st->usesCUPTI = uCUPTI;
+            if (uCUPTI) {
+                st->nk += nKernelCalls;
+            }
+            if (hw_counters) {
+                for (int i = 0; i < NHWCounters; ++i) st->hwex[i] += hwex[i];
+            }
+        }
 
-#ifdef AMREX_USE_CUDA
-            nvtxRangeEnd(nvtx_id);
-#endif
-        } else 
-        {
-            improperly_nested_timers.insert(fname);
+        ttstack.pop_back();
+        if (!ttstack.empty()) {
+            std::tuple<double,double,TimerName const*>& parent = ttstack.back();
+            std::get<1>(parent) += dtin;
+        }
+        if (hw_counters) {
+            hwstack.pop_back();
+            if (!hwstack.empty()) {
+                HWFrame& parent = hwstack.back();
+                for (int i = 0; i < NHWCounters; ++i) parent.child[i] += hwin[i];
+            }
         }
 
-        stats.clear();
+#ifdef AMREX_USE_CUDA
+        nvtxRangeEnd(nvtx_id);
+#endif
+    } else {
+#ifdef _OPENMP
+#pragma omp critical(tinyprofiler_improper)
+#endif
+        improperly_nested_timers.insert(fname->name);
     }
+
+    stats.clear();
 }
-#endif
 
 void
 TinyProfiler::Initialize () noexcept
 {
-    regionstack.push_back(mainregion);
+    if (regionnames.empty()) {
+        regionnames.push_back(mainregion);
+    }
+    if (regionstack.empty()) {
+        regionstack.push_back(0);
+    }
+    tstates.resize(OpenMP::get_max_threads());
+    hw_finalized = false;
+
+    {
+        ParmParse pp("tiny_profiler");
+        int hw = 0;
+        pp.query("hw_counters", hw);
+#if defined(__linux__)
+        hw_counters = hw;
+#endif
+    }
+
     t_init = amrex::second();
 }
 
@@ -254,6 +391,11 @@ TinyProfiler::Finalize (bool bFlushing) noexcept
 {
     static bool finalized = false;
     if (!bFlushing) {		// If flushing, don't make this the last time!
+        // timers started after this do not reopen the counters
+        hw_finalized = true;
+        for (auto& ts : tstates) {
+            CloseHWCounters(ts);
+        }
         if (finalized) {
             return;
         } else {
@@ -263,8 +405,29 @@ TinyProfiler::Finalize (bool bFlushing) noexcept
 
     double t_final = amrex::second();
 
-    // make a local copy so that any functions call after this will not be recorded in the local copy.
-    auto lstatsmap = statsmap;
+    // Merge the per-thread stats into a local copy so that any functions
+    // called after this will not be recorded in the local copy.
+    std::map<std::string,std::map<std::string, ThreadStats> > lstatsmap;
+    for (auto const& ts : tstates) {
+        for (int region = 0; region < static_cast<int>(ts.stats.size()); ++region) {
+            auto& regstats = lstatsmap[regionnames[region]];
+            auto const& tregstats = ts.stats[region];
+            for (int id = 0; id < static_cast<int>(tregstats.size()); ++id) {
+                Stats const& st = tregstats[id];
+                if (st.n == 0) continue;
+                ThreadStats& mst = regstats[timernames[id].name];
+                mst.n += st.n;
+                mst.dtin = std::max(mst.dtin, st.dtin);
+                mst.dtex = std::max(mst.dtex, st.dtex);
+                mst.usesCUPTI = mst.usesCUPTI || st.usesCUPTI;
+                ++mst.nthreads;
+                mst.dtexmin = std::min(mst.dtexmin, st.dtex);
+                mst.dtexsum += st.dtex;
+                mst.dtexmax = std::max(mst.dtexmax, st.dtex);
+                for (int i = 0; i < NHWCounters; ++i) mst.hwex[i] += st.hwex[i];
+            }
+        }
+    }
 
     bool properly_nested = improperly_nested_timers.size() == 0;
     ParallelDescriptor::ReduceBoolAnd(properly_nested);
@@ -321,7 +484,7 @@ TinyProfiler::Finalize (bool bFlushing) noexcept
         if (!alreadySynced) {
             for (auto const& s : syncedRegions) {
                 if (lstatsmap.find(s) == lstatsmap.end()) {
-                    lstatsmap.insert(std::make_pair(s,std::map<std::string,Stats>()));
+                    lstatsmap.insert(std::make_pair(s,std::map<std::string,ThreadStats>()));
                 }
             }
         }
@@ -338,7 +501,7 @@ TinyProfiler::Finalize (bool bFlushing) noexcept
 }
 
 void
-TinyProfiler::PrintStats (std::map<std::string,Stats>& regstats, double dt_max)
+TinyProfiler::PrintStats (std::map<std::string,ThreadStats>& regstats, double dt_max)
 {
     // make sure the set of profiled functions is the same on all processes
     {
@@ -354,7 +517,7 @@ TinyProfiler::PrintStats (std::map<std::string,Stats>& regstats, double dt_max)
         if (! alreadySynced) {  // add the new name
             for (auto const& s : syncedStrings) {
                 if (regstats.find(s) == regstats.end()) {
-                    regstats.insert(std::make_pair(s, Stats()));
+                    regstats.insert(std::make_pair(s, ThreadStats()));
                 }
             }
         }
@@ -368,25 +531,29 @@ TinyProfiler::PrintStats (std::map<std::string,Stats>& regstats, double dt_max)
     std::vector<ProcStats> allprocstats;
     int maxfnamelen = 0;
     Long maxncalls = 0;
+    bool threaded = false;
 
     // now collect global data onto the ioproc
+    constexpr int nd = 6 + NHWCounters;
     for (auto it = regstats.cbegin(); it != regstats.cend(); ++it)
     {
         Long n = it->second.n;
-        double dts[2] = {it->second.dtin, it->second.dtex};
+        double dts[nd] = {it->second.dtin, it->second.dtex,
+                          double(it->second.nthreads), it->second.dtexmin,
+                          it->second.dtexsum, it->second.dtexmax};
+        for (int i = 0; i < NHWCounters; ++i) dts[6+i] = it->second.hwex[i];
 
         std::vector<Long> ncalls(nprocs);
-        std::vector<double> dtdt(2*nprocs);
+        std::vector<double> dtdt(nd*nprocs);
 
         if (ParallelDescriptor::NProcs() == 1)
         {
             ncalls[0] = n;
-            dtdt[0] = dts[0];
-            dtdt[1] = dts[1];
+            std::copy(dts, dts+nd, dtdt.begin());
         } else
         {
             ParallelDescriptor::Gather(&n, 1, &ncalls[0], 1, ioproc);
-            ParallelDescriptor::Gather(dts, 2, &dtdt[0], 2, ioproc);
+            ParallelDescriptor::Gather(dts, nd, &dtdt[0], nd, ioproc);
         }
 
         if (ParallelDescriptor::IOProcessor()) {
@@ -395,16 +562,32 @@ TinyProfiler::PrintStats (std::map<std::string,Stats>& regstats, double dt_max)
                 pst.nmin  = std::min(pst.nmin, ncalls[i]);
                 pst.navg +=                    ncalls[i];
                 pst.nmax  = std::max(pst.nmax, ncalls[i]);
-                pst.dtinmin  = std::min(pst.dtinmin, dtdt[2*i]);
-                pst.dtinavg +=                       dtdt[2*i];
-                pst.dtinmax  = std::max(pst.dtinmax, dtdt[2*i]);
-                pst.dtexmin  = std::min(pst.dtexmin, dtdt[2*i+1]);
-                pst.dtexavg +=                       dtdt[2*i+1];
-                pst.dtexmax  = std::max(pst.dtexmax, dtdt[2*i+1]);
+                pst.dtinmin  = std::min(pst.dtinmin, dtdt[nd*i]);
+                pst.dtinavg +=                       dtdt[nd*i];
+                pst.dtinmax  = std::max(pst.dtinmax, dtdt[nd*i]);
+                pst.dtexmin  = std::min(pst.dtexmin, dtdt[nd*i+1]);
+                pst.dtexavg +=                       dtdt[nd*i+1];
+                pst.dtexmax  = std::max(pst.dtexmax, dtdt[nd*i+1]);
+                const int nthreads = static_cast<int>(dtdt[nd*i+2]);
+                if (nthreads > 0) {
+                    pst.nthreads += nthreads;
+                    pst.tdtexmin  = std::min(pst.tdtexmin, dtdt[nd*i+3]);
+                    pst.tdtexavg +=                        dtdt[nd*i+4];
+                    pst.tdtexmax  = std::max(pst.tdtexmax, dtdt[nd*i+5]);
+                    threaded = threaded || (nthreads > 1);
+                }
+                for (int j = 0; j < NHWCounters; ++j) {
+                    pst.hwex[j] += dtdt[nd*i+6+j];
+                }
             }
             pst.navg /= nprocs;
             pst.dtinavg /= nprocs;
             pst.dtexavg /= nprocs;
+            if (pst.nthreads > 0) {
+                pst.tdtexavg /= pst.nthreads;
+            } else {
+                pst.tdtexmin = 0.0;
+            }
             pst.fname = it->first;
 #ifdef AMREX_USE_CUPTI
             pst.usesCUPTI = it->second.usesCUPTI;
@@ -530,22 +713,122 @@ TinyProfiler::PrintStats (std::map<std::string,Stats>& regstats, double dt_max)
 #endif
         }
         amrex::OutStream() << hline << "\n";
+
+        // Exclusive time across threads and processes for timers called in threaded regions
+        if (threaded)
+        {
+            std::sort(allprocstats.begin(), allprocstats.end(), ProcStats::compthr);
+            amrex::OutStream() << "\n" << hline << "\n";
+            amrex::OutStream() << std::left
+                               << std::setw(maxfnamelen) << "Name"
+                               << std::right
+                               << std::setw(wnc+2) << "NThrds"
+                               << std::setw(wt+2) << "Thrd. Min"
+                               << std::setw(wt+2) << "Thrd. Avg"
+                               << std::setw(wt+2) << "Thrd. Max"
+                               << std::setw(wp+2)  << "Imbal."
+                               << "\n" << hline << "\n";
+            for (auto it = allprocstats.cbegin(); it != allprocstats.cend(); ++it)
+            {
+                if (it->nthreads <= nprocs) continue;
+                // imbalance: max over avg exclusive time of a (process, thread) pair
+                const double imbalance = (it->tdtexavg > 0.0) ? it->tdtexmax/it->tdtexavg : 1.0;
+                amrex::OutStream() << std::setprecision(4) << std::left
+                                   << std::setw(maxfnamelen) << it->fname
+                                   << std::right
+                                   << std::setw(wnc+2) << it->nthreads
+                                   << std::setw(wt+2) << it->tdtexmin
+                                   << std::setw(wt+2) << it->tdtexavg
+                                   << std::setw(wt+2) << it->tdtexmax
+                                   << std::setprecision(2) << std::setw(wp+2) << std::fixed
+                                   << imbalance;
+                amrex::OutStream().unsetf(std::ios_base::fixed);
+                amrex::OutStream() << "\n";
+            }
+            amrex::OutStream() << hline << "\n";
+        }
+
+        if (hw_counters) PrintHWStats(allprocstats, maxfnamelen);
+
         amrex::OutStream() << std::endl;
     }
 }
 
+void
+TinyProfiler::PrintHWStats (std::vector<ProcStats>& allprocstats, int maxfnamelen)
+{
+    bool available = false;
+    for (auto const& pst : allprocstats) {
+        available = available || (pst.hwex[0] > 0.);
+    }
+    if (!available) {
+        amrex::OutStream() << "\nTinyProfiler: hardware counters are not available\n";
+        return;
+    }
+
+    // Exclusive hardware counts summed over threads and processes.  The
+    // achieved bandwidth uses the maximum exclusive time over processes and
+    // assumes one cache line of memory traffic per last-level cache miss.
+    std::sort(allprocstats.begin(), allprocstats.end(), ProcStats::compex);
+
+    const int wc = 11;
+    const std::string hline(maxfnamelen+(wc+2)*6,'-');
+    amrex::OutStream() << "\n" << hline << "\n";
+    amrex::OutStream() << std::left
+                       << std::setw(maxfnamelen) << "Name"
+                       << std::right
+                       << std::setw(wc+2) << "Cycles"
+                       << std::setw(wc+2) << "Instr."
+                       << std::setw(wc+2) << "IPC"
+                       << std::setw(wc+2) << "LLC Misses"
+                       << std::setw(wc+2) << "GB/s"
+                       << std::setw(wc+2) << "Instr./Byte"
+                       << "\n" << hline << "\n";
+    for (auto it = allprocstats.cbegin(); it != allprocstats.cend(); ++it)
+    {
+        const double cycles = it->hwex[0];
+        const double instrs = it->hwex[1];
+        const double bytes  = it->hwex[2] * cache_line_bytes;
+        const double ipc = (cycles > 0.) ? instrs/cycles : 0.;
+        const double bw = (it->dtexmax > 0.) ? bytes/it->dtexmax*1.e-9 : 0.;
+        const double ai = (bytes > 0.) ? instrs/bytes : 0.;
+        amrex::OutStream() << std::setprecision(4) << std::left
+                           << std::setw(maxfnamelen) << it->fname
+                           << std::right
+                           << std::setw(wc+2) << cycles
+                           << std::setw(wc+2) << instrs
+                           << std::setw(wc+2) << ipc
+                           << std::setw(wc+2) << it->hwex[2]
+                           << std::setw(wc+2) << bw
+                           << std::setw(wc+2) << ai
+                           << "\n";
+    }
+    amrex::OutStream() << hline << "\n";
+}
+
 void
 TinyProfiler::StartRegion (std::string regname) noexcept
 {
-    if (std::find(regionstack.begin(), regionstack.end(), regname) == regionstack.end()) {
-        regionstack.emplace_back(std::move(regname));
+    // The region stack is shared by all threads and can only be changed
+    // outside OpenMP parallel regions.
+    if (OpenMP::in_parallel()) return;
+
+    auto found = std::find(regionnames.begin(), regionnames.end(), regname);
+    int region = found - regionnames.begin();
+    if (found == regionnames.end()) {
+        regionnames.emplace_back(std::move(regname));
+    }
+    if (std::find(regionstack.begin(), regionstack.end(), region) == regionstack.end()) {
+        regionstack.push_back(region);
     }
 }
 
 void
 TinyProfiler::StopRegion (const std::string& regname) noexcept
 {
-    if (regname == regionstack.back()) {
+    if (OpenMP::in_parallel()) return;
+
+    if (!regionstack.empty() && regname == regionnames[regionstack.back()]) {
         regionstack.pop_back();
     }
 }
@@ -576,8 +859,11 @@ void
 TinyProfiler::PrintCallStack (std::ostream& os)
 {
     os << "===== TinyProfilers ======\n";
-    for (auto const& x : ttstack) {
-        os << *(std::get<2>(x)) << "\n";
+    const int tid = OpenMP::get_thread_num();
+    if (tid < static_cast<int>(tstates.size())) {
+        for (auto const& x : tstates[tid].ttstack) {
+            os << std::get<2>(x)->name << "\n";
+        }
     }
 }
 
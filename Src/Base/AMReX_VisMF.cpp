@@ -562,6 +562,12 @@ VisMF::readFAB (int idx,
     return VisMF::readFAB(idx, m_fafabname, m_hdr, ncomp);
 }
 
+FArrayBox*
+VisMF::readFAB (int idx, const Box& region, int scomp, int ncomp)
+{
+    return VisMF::readFAB(idx, m_fafabname, m_hdr, region, scomp, ncomp);
+}
+
 std::string
 VisMF::BaseName (const std::string& filename)
 {
@@ -1450,6 +1456,152 @@ VisMF::readFAB (int                  idx,
 }
 
 
+FArrayBox*
+VisMF::readFAB (int                  idx,
+                const std::string   &mf_name,
+                const VisMF::Header &hdr,
+                const Box           &region,
+                int                  scomp,
+                int                  ncomp)
+{
+    BL_PROFILE("VisMF::readFAB_region");
+    BL_ASSERT(scomp >= 0 && ncomp > 0 && scomp+ncomp <= hdr.m_ncomp);
+
+    Box fab_box(hdr.m_ba[idx]);
+    if(hdr.m_ngrow.max() > 0) {
+        fab_box.grow(hdr.m_ngrow);
+    }
+
+    const Box bx = fab_box & region;
+    if( ! bx.ok()) {
+        return nullptr;
+    }
+
+    std::string FullName(VisMF::DirName(mf_name));
+    FullName += hdr.m_fod[idx].m_name;
+
+    std::ifstream *infs = VisMF::OpenStream(FullName);
+    infs->seekg(hdr.m_fod[idx].m_head, std::ios::beg);
+
+    RealDescriptor rd;
+    if(NoFabHeader(hdr)) {
+        rd = hdr.m_writtenRD;
+    } else {
+        //
+        // Parse the FAB header to find the RealDescriptor and the start of
+        // the data.  The old "FAB:" format is read in full.
+        //
+        char c[4];
+        *infs >> c[0] >> c[1] >> c[2] >> c[3];
+        if(c[0] != 'F' || c[1] != 'A' || c[2] != 'B') {
+            amrex::Error("VisMF::readFAB(): expected FAB header");
+        }
+        if(c[3] == ':') {
+            VisMF::CloseStream(FullName);
+            FArrayBox *fab = new FArrayBox(bx, ncomp);
+            for(int n(0); n < ncomp; ++n) {
+                std::unique_ptr<FArrayBox> tmp(VisMF::readFAB(idx, mf_name, hdr, scomp+n));
+                fab->copy<RunOn::Host>(*tmp, bx, 0, bx, n, 1);
+            }
+            return fab;
+        }
+        infs->putback(c[3]);
+        Box hbx;
+        int nvar;
+        *infs >> rd >> hbx >> nvar;
+        infs->ignore(BL_IGNORE_MAX, '\n');
+        if(infs->fail() || hbx != fab_box || nvar != hdr.m_ncomp) {
+            amrex::Error("VisMF::readFAB(): inconsistent FAB header");
+        }
+    }
+
+    FArrayBox *fab = new FArrayBox(bx, ncomp);
+
+    //
+    // The FAB on disk is stored component by component, each in Fortran
+    // order.  Read the rows of bx, merging the ones that are contiguous
+    // on disk, so that reading a whole FAB is a single read.
+    //
+    const std::streamoff data_start = infs->tellg();
+    const Long nbytes = rd.numBytes();
+    const bool native = (rd == FPC::NativeRealDescriptor());
+    const auto flo  = amrex::lbound(fab_box);
+    const auto flen = amrex::length(fab_box);
+    const auto blo  = amrex::lbound(bx);
+    const auto bhi  = amrex::ubound(bx);
+    const Long rowlen = bx.length(0);
+
+    Long run_off = -1, run_len = 0;
+    Real *run_dst = nullptr;
+    auto flush_run = [&] () {
+        if(run_len > 0) {
+            infs->seekg(data_start + run_off*nbytes, std::ios::beg);
+            if(native) {
+                infs->read((char *) run_dst, run_len*nbytes);
+            } else {
+                RealDescriptor::convertToNativeFormat(run_dst, run_len, *infs, rd);
+            }
+            if(infs->fail()) {
+                amrex::Error("VisMF::readFAB(): read failed");
+            }
+        }
+    };
+
+    Real *dst = fab->dataPtr();
+    for(int n(scomp); n < scomp+ncomp; ++n) {
+        for(int k(blo.z); k <= bhi.z; ++k) {
+            for(int j(blo.y); j <= bhi.y; ++j) {
+                const Long off = n*fab_box.numPts()
+                    + ((k-flo.z)*static_cast<Long>(flen.y) + (j-flo.y))*flen.x
+                    + (blo.x-flo.x);
+                if(run_off >= 0 && off == run_off+run_len && dst == run_dst+run_len) {
+                    run_len += rowlen;
+                } else {
+                    flush_run();
+                    run_off = off;
+                    run_len = rowlen;
+                    run_dst = dst;
+                }
+                dst += rowlen;
+            }
+        }
+    }
+    flush_run();
+
+    VisMF::CloseStream(FullName);
+
+    return fab;
+}
+
+
+void
+VisMF::Read (FabArray<FArrayBox> &mf,
+             const std::string   &mf_name,
+             const Box           &region)
+{
+    BL_PROFILE("VisMF::Read(region)");
+
+    VisMF vismf(mf_name);
+    const Header& hdr = vismf.m_hdr;
+
+    if( ! mf.boxArray().CellEqual(hdr.m_ba)) {
+        amrex::Abort("VisMF::Read(region): BoxArray does not match the one on disk");
+    }
+    BL_ASSERT(mf.nComp() <= hdr.m_ncomp);
+
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.fabbox() & region;
+        if(bx.ok()) {
+            std::unique_ptr<FArrayBox> fab(VisMF::readFAB(mfi.index(), mf_name, hdr,
+                                                          bx, 0, mf.nComp()));
+            if(fab) {
+                mf[mfi].copy<RunOn::Host>(*fab, fab->box(), 0, fab->box(), 0, mf.nComp());
+            }
+        }
+    }
+}
+
+
 void
 VisMF::readFAB (FabArray<FArrayBox> &mf,
 		int                  idx,
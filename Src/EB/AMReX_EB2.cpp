@@ -11,7 +11,11 @@
 #include <AMReX_EB2.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX.H>
+#include <AMReX_Utility.H>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
 
 namespace amrex { namespace EB2 {
 
@@ -63,6 +67,135 @@ const IndexSpace* TopIndexSpaceIfPresent() noexcept {
     return nullptr;
 }
 
+namespace {
+    void fnv1a (std::uint64_t& h, const void* p, std::size_t n) noexcept
+    {
+        const unsigned char* c = static_cast<const unsigned char*>(p);
+        for (std::size_t i = 0; i < n; ++i) {
+            h ^= c[i];
+            h *= 1099511628211ULL;
+        }
+    }
+}
+
+std::uint64_t
+IndexSpaceHash (const Vector<Long>& idata, const Vector<Real>& rdata, const std::string& iftype)
+{
+    std::string cache_key;
+    {
+        ParmParse pp("eb2");
+        pp.query("cache_key", cache_key);
+    }
+
+    std::uint64_t h = 14695981039346656037ULL;
+    fnv1a(h, idata.data(), idata.size()*sizeof(Long));
+    fnv1a(h, rdata.data(), rdata.size()*sizeof(Real));
+    fnv1a(h, iftype.data(), iftype.size());
+    fnv1a(h, cache_key.data(), cache_key.size());
+    return h;
+}
+
+std::string
+IndexSpaceCacheDir (std::uint64_t hash)
+{
+    std::string cache_dir, cache_key;
+    {
+        ParmParse pp("eb2");
+        pp.query("cache_dir", cache_dir);
+        pp.query("cache_key", cache_key);
+    }
+    if (cache_dir.empty()) return cache_dir;
+
+    // The hash only samples the implicit function, so it cannot tell apart
+    // geometries that differ in small features.  The key must identify them.
+    if (cache_key.empty()) {
+        amrex::Abort("EB2: eb2.cache_key must be set when eb2.cache_dir is set");
+    }
+
+    std::ostringstream ss;
+    ss << cache_dir << "/IndexSpace_" << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return ss.str();
+}
+
+bool
+ReadIndexSpaceHeader (const std::string& dir, std::uint64_t hash, Vector<int>& ngrow)
+{
+    const std::string hname = dir + "/Header";
+
+    int exist = 0;
+    if (ParallelDescriptor::IOProcessor()) {
+        exist = amrex::FileExists(hname);
+    }
+    ParallelDescriptor::Bcast(&exist, 1, ParallelDescriptor::IOProcessorNumber());
+    if (!exist) return false;
+
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(hname, fileCharPtr);
+    std::istringstream is(fileCharPtr.dataPtr(), std::istringstream::in);
+
+    std::string cache_key;
+    {
+        ParmParse pp("eb2");
+        pp.query("cache_key", cache_key);
+    }
+
+    std::string version, key;
+    int vers = 0;
+    std::uint64_t h = 0;
+    int nlevs = 0;
+    is >> version >> vers;
+    std::getline(is, key); // eat the rest of the line
+    std::getline(is, key);
+    is >> h >> nlevs;
+    if (version != "EB2::IndexSpace" || vers != 2 || key != cache_key || h != hash || nlevs <= 0) {
+        return false;
+    }
+
+    ngrow.resize(nlevs);
+    for (auto& ng : ngrow) {
+        is >> ng;
+    }
+    return !is.fail();
+}
+
+void
+WriteIndexSpace (const std::string& dir, std::uint64_t hash,
+                 const Vector<Level const*>& levels, const Vector<int>& ngrow)
+{
+    BL_PROFILE("EB2::WriteIndexSpace()");
+
+    if (ParallelDescriptor::IOProcessor()) {
+        if (!amrex::UtilCreateDirectory(dir, 0755)) {
+            amrex::CreateDirectoryFailed(dir);
+        }
+    }
+    ParallelDescriptor::Barrier();
+
+    for (int ilev = 0; ilev < levels.size(); ++ilev) {
+        levels[ilev]->write(dir+"/Level_"+std::to_string(ilev));
+    }
+
+    // The header is written last so that an incomplete cache is never read.
+    ParallelDescriptor::Barrier();
+    if (ParallelDescriptor::IOProcessor())
+    {
+        const std::string hname = dir + "/Header";
+        std::ofstream os(hname.c_str(), std::ios::out | std::ios::trunc);
+        if (!os.good()) {
+            amrex::FileOpenFailed(hname);
+        }
+        std::string cache_key;
+        {
+            ParmParse pp("eb2");
+            pp.query("cache_key", cache_key);
+        }
+        os << "EB2::IndexSpace 2\n" << cache_key << '\n' << hash << '\n' << levels.size() << '\n';
+        for (auto ng : ngrow) {
+            os << ng << '\n';
+        }
+    }
+}
+
 void
 Build (const Geometry& geom, int required_coarsening_level,
        int max_coarsening_level, int ngrow, bool build_coarse_level_by_coarsening)
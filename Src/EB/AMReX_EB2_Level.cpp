@@ -1,7 +1,10 @@
 
 #include <AMReX_EB2_Level.H>
 #include <AMReX_IArrayBox.H>
+#include <AMReX_Utility.H>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 
 namespace amrex { namespace EB2 {
 
@@ -869,4 +872,137 @@ Level::fillLevelSet (MultiFab& levelset, const Geometry& geom) const
     }
 }
         
+void
+Level::write (const std::string& dir) const
+{
+    BL_PROFILE("EB2::Level::write()");
+
+    if (ParallelDescriptor::IOProcessor()) {
+        if (!amrex::UtilCreateDirectory(dir, 0755)) {
+            amrex::CreateDirectoryFailed(dir);
+        }
+    }
+    ParallelDescriptor::Barrier();
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::string hname = dir + "/Header";
+        std::ofstream os(hname.c_str(), std::ios::out | std::ios::trunc);
+        if (!os.good()) {
+            amrex::FileOpenFailed(hname);
+        }
+        os << "EB2::Level 1\n"
+           << m_allregular << ' ' << m_ok << '\n'
+           << m_ngrow << '\n'
+           << m_levelset.nGrowVect() << '\n';
+        m_grids.writeOn(os);
+        os << '\n';
+        m_covered_grids.writeOn(os);
+        os << '\n';
+        if (!os.good()) {
+            amrex::Abort("EB2::Level::write: failed to write "+hname);
+        }
+    }
+
+    if (m_grids.empty()) return;
+
+    VisMF::Write(m_levelset , dir+"/LevelSet");
+    VisMF::Write(m_volfrac  , dir+"/VolFrac");
+    VisMF::Write(m_centroid , dir+"/Centroid");
+    VisMF::Write(m_bndryarea, dir+"/BndryArea");
+    VisMF::Write(m_bndrycent, dir+"/BndryCent");
+    VisMF::Write(m_bndrynorm, dir+"/BndryNorm");
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        VisMF::Write(m_areafrac[idim], dir+"/AreaFrac_"+std::to_string(idim));
+        VisMF::Write(m_facecent[idim], dir+"/FaceCent_"+std::to_string(idim));
+    }
+
+    // The cell flags are stored as two 16-bit halves so that they are
+    // represented exactly, also in single precision.
+    MultiFab cflag(m_grids, m_dmap, 2, m_cellflag.nGrow());
+    for (MFIter mfi(cflag); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.fabbox();
+        auto const& src = m_cellflag.const_array(mfi);
+        auto const& dst = cflag.array(mfi);
+        AMREX_HOST_DEVICE_FOR_3D ( bx, i, j, k,
+        {
+            const uint32_t v = src(i,j,k).getValue();
+            dst(i,j,k,0) = static_cast<Real>(v & 0xffff);
+            dst(i,j,k,1) = static_cast<Real>(v >> 16);
+        });
+    }
+    VisMF::Write(cflag, dir+"/CellFlag");
+}
+
+void
+Level::read (const std::string& dir)
+{
+    BL_PROFILE("EB2::Level::read()");
+
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(dir+"/Header", fileCharPtr);
+    std::istringstream is(fileCharPtr.dataPtr(), std::istringstream::in);
+
+    std::string version;
+    int vers;
+    is >> version >> vers;
+    if (version != "EB2::Level" || vers != 1) {
+        amrex::Abort("EB2::Level::read: unknown format in "+dir);
+    }
+
+    IntVect ls_ngrow;
+    is >> m_allregular >> m_ok >> m_ngrow >> ls_ngrow;
+    m_grids.readFrom(is);
+    m_covered_grids.readFrom(is);
+
+    if (m_grids.empty()) return;
+
+    m_dmap = DistributionMapping(m_grids);
+
+    const int ng = 2;
+    MFInfo mf_info;
+    mf_info.SetTag("EB2::Level");
+    m_levelset.define(amrex::convert(m_grids,IntVect::TheNodeVector()), m_dmap, 1, ls_ngrow, mf_info);
+    m_cellflag.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_volfrac.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_centroid.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    m_bndryarea.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_bndrycent.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    m_bndrynorm.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_areafrac[idim].define(amrex::convert(m_grids, IntVect::TheDimensionVector(idim)),
+                                m_dmap, 1, ng, mf_info);
+        m_facecent[idim].define(amrex::convert(m_grids, IntVect::TheDimensionVector(idim)),
+                                m_dmap, AMREX_SPACEDIM-1, ng, mf_info);
+    }
+
+    VisMF::Read(m_levelset , dir+"/LevelSet");
+    VisMF::Read(m_volfrac  , dir+"/VolFrac");
+    VisMF::Read(m_centroid , dir+"/Centroid");
+    VisMF::Read(m_bndryarea, dir+"/BndryArea");
+    VisMF::Read(m_bndrycent, dir+"/BndryCent");
+    VisMF::Read(m_bndrynorm, dir+"/BndryNorm");
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        VisMF::Read(m_areafrac[idim], dir+"/AreaFrac_"+std::to_string(idim));
+        VisMF::Read(m_facecent[idim], dir+"/FaceCent_"+std::to_string(idim));
+    }
+
+    MultiFab cflag(m_grids, m_dmap, 2, ng);
+    VisMF::Read(cflag, dir+"/CellFlag");
+    for (MFIter mfi(cflag); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.fabbox();
+        auto const& src = cflag.const_array(mfi);
+        auto const& dst = m_cellflag.array(mfi);
+        AMREX_HOST_DEVICE_FOR_3D ( bx, i, j, k,
+        {
+            const uint32_t lo = static_cast<uint32_t>(src(i,j,k,0));
+            const uint32_t hi = static_cast<uint32_t>(src(i,j,k,1));
+            dst(i,j,k) = EBCellFlag(lo | (hi << 16));
+        });
+    }
+}
+
+
 }}
@@ -0,0 +1,422 @@
+#include <AMReX_EB_FacetGrid.H>
+
+#include <AMReX_BLProfiler.H>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace amrex {
+
+namespace {
+
+    inline Real dot3 (const Real* a, const Real* b) noexcept
+    {
+        return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+    }
+
+    //! Line given by the intersection of the planes n1.x = h1 and n2.x = h2
+    void calc_facet_edge (Real* p0, Real* v, Real h1, Real h2, const Real* n1, const Real* n2) noexcept
+    {
+        const Real c_dp   = dot3(n1, n2);
+        const Real c_norm = 1.0 - c_dp * c_dp;
+
+        const Real c1 = (h1 - h2 * c_dp) / c_norm;
+        const Real c2 = (h2 - h1 * c_dp) / c_norm;
+
+        for (int d = 0; d < 3; ++d) {
+            p0[d] = c1 * n1[d] + c2 * n2[d];
+        }
+        v[0] = n1[1]*n2[2] - n1[2]*n2[1];
+        v[1] = n1[2]*n2[0] - n1[0]*n2[2];
+        v[2] = n1[0]*n2[1] - n1[1]*n2[0];
+    }
+
+    //! Range of the line coordinate for which p0 + lambda*v is inside cell `id_cell`
+    void lambda_bounds (Real& lambda_min, Real& lambda_max, const int* id_cell,
+                        const Real* p0, const Real* v, const Real* dx) noexcept
+    {
+        lambda_min = std::numeric_limits<Real>::lowest();
+        lambda_max = std::numeric_limits<Real>::max();
+
+        for (int d = 0; d < 3; ++d) {
+            // lines running parallel to a face are not bounded by it
+            if (std::abs(v[d]) > std::numeric_limits<Real>::epsilon()) {
+                Real c_lo = -(p0[d] -  static_cast<Real>(id_cell[d])        * dx[d]) / v[d];
+                Real c_hi = -(p0[d] - (static_cast<Real>(id_cell[d]) + 1.0) * dx[d]) / v[d];
+                if (v[d] < 0.0) std::swap(c_lo, c_hi);
+                lambda_min = std::max(lambda_min, c_lo);
+                lambda_max = std::min(lambda_max, c_hi);
+            }
+        }
+    }
+}
+
+EBFacetGrid::EBFacetGrid (Vector<Real>&& facets, const RealVect& dx_eb, int bucket_size)
+    : m_facets(std::move(facets)),
+      m_nfacets(m_facets.size()/6)
+{
+    BL_PROFILE("EBFacetGrid::EBFacetGrid()");
+
+    bucket_size = std::max(bucket_size, 1);
+
+    for (int d = 0; d < 3; ++d) {
+        m_dx_eb[d] = (d < AMREX_SPACEDIM) ? dx_eb[d] : 1.0;
+        m_lo[d] = 0.0;
+        m_h[d] = bucket_size * m_dx_eb[d];
+        m_n[d] = 1;
+    }
+
+    if (m_nfacets > 0)
+    {
+        Real hi[3];
+        for (int d = 0; d < 3; ++d) {
+            m_lo[d] = hi[d] = m_facets[d];
+        }
+        for (int i = 1; i < m_nfacets; ++i) {
+            for (int d = 0; d < 3; ++d) {
+                m_lo[d] = std::min(m_lo[d], m_facets[6*i+d]);
+                hi[d]   = std::max(hi[d],   m_facets[6*i+d]);
+            }
+        }
+        for (int d = 0; d < 3; ++d) {
+            m_n[d] = static_cast<int>((hi[d]-m_lo[d])/m_h[d]) + 1;
+        }
+    }
+
+    // counting sort of the facets by bucket, preserving the facet order
+    // within each bucket
+    const int nbuckets = m_n[0]*m_n[1]*m_n[2];
+    m_offset.assign(nbuckets+1, 0);
+    Vector<int> ibucket(m_nfacets);
+    int iv[3];
+    for (int i = 0; i < m_nfacets; ++i) {
+        ibucket[i] = bucket(&m_facets[6*i], iv);
+        ++m_offset[ibucket[i]+1];
+    }
+    for (int b = 0; b < nbuckets; ++b) {
+        m_offset[b+1] += m_offset[b];
+    }
+    m_index.resize(m_nfacets);
+    Vector<int> pos(m_offset.begin(), m_offset.end()-1);
+    for (int i = 0; i < m_nfacets; ++i) {
+        m_index[pos[ibucket[i]]++] = i;
+    }
+}
+
+int
+EBFacetGrid::bucket (const Real* pos, int* iv) const noexcept
+{
+    for (int d = 0; d < 3; ++d) {
+        Real x = std::floor((pos[d]-m_lo[d])/m_h[d]);
+        iv[d] = (x < 0.0) ? 0 : ((x >= m_n[d]) ? m_n[d]-1 : static_cast<int>(x));
+    }
+    return iv[0] + m_n[0]*(iv[1] + m_n[1]*iv[2]);
+}
+
+int
+EBFacetGrid::nearest (const Real* pos, Real& dist2) const noexcept
+{
+    int c[3];
+    bucket(pos, c);
+
+    int  i_nearest = -1;
+    Real min_dist2 = std::numeric_limits<Real>::max();
+
+    auto search_bucket = [&] (int i, int j, int k) noexcept
+    {
+        const int b = i + m_n[0]*(j + m_n[1]*k);
+        for (int n = m_offset[b]; n < m_offset[b+1]; ++n) {
+            const int f = m_index[n];
+            const Real* cent = &m_facets[6*f];
+            const Real r[3] = {pos[0]-cent[0], pos[1]-cent[1], pos[2]-cent[2]};
+            const Real d2 = dot3(r, r);
+            if (d2 < min_dist2 || (d2 == min_dist2 && f < i_nearest)) {
+                min_dist2 = d2;
+                i_nearest = f;
+            }
+        }
+    };
+
+    for (int r = 0; ; ++r)
+    {
+        // buckets on the shell at (Chebyshev) distance r from c
+        const int klo = std::max(c[2]-r, 0), khi = std::min(c[2]+r, m_n[2]-1);
+        const int jlo = std::max(c[1]-r, 0), jhi = std::min(c[1]+r, m_n[1]-1);
+        const int ilo = std::max(c[0]-r, 0), ihi = std::min(c[0]+r, m_n[0]-1);
+        for (int k = klo; k <= khi; ++k) {
+            for (int j = jlo; j <= jhi; ++j) {
+                if (std::abs(k-c[2]) == r || std::abs(j-c[1]) == r) {
+                    for (int i = ilo; i <= ihi; ++i) {
+                        search_bucket(i,j,k);
+                    }
+                } else {
+                    if (c[0]-r >= 0)     search_bucket(c[0]-r,j,k);
+                    if (c[0]+r < m_n[0] && r > 0) search_bucket(c[0]+r,j,k);
+                }
+            }
+        }
+
+        // lower bound of the distance to facets outside of the searched
+        // buckets
+        bool done = true;
+        Real bound = std::numeric_limits<Real>::max();
+        for (int d = 0; d < 3; ++d) {
+            if (c[d]-r > 0) {
+                done = false;
+                bound = std::min(bound, pos[d] - (m_lo[d] + (c[d]-r)*m_h[d]));
+            }
+            if (c[d]+r < m_n[d]-1) {
+                done = false;
+                bound = std::min(bound, (m_lo[d] + (c[d]+r+1)*m_h[d]) - pos[d]);
+            }
+        }
+        if (done) break;
+        // be conservative w.r.t. round-off in the bucket assignment
+        bound *= (1.0 - 1.e-10);
+        if (i_nearest >= 0 && bound > 0.0 && min_dist2 < bound*bound) break;
+    }
+
+    dist2 = min_dist2;
+    return i_nearest;
+}
+
+Real
+EBFacetGrid::nearest_edge_dist2 (const int* ind_pt, const int* ind_loop, const Real* r_vec,
+                                 const Real* eb_normal, const Real* eb_p0) const noexcept
+{
+    // Port of facets_nearest_pt (AMReX_EB_geometry.F90): nearest point on the
+    // edges of the EB facet in cell `ind_loop` that face cell `ind_pt`.
+    const Real eb_h = dot3(eb_normal, eb_p0);
+
+    Real c_vec[3] = {eb_p0[0], eb_p0[1], eb_p0[2]};
+    Real min_dist = std::numeric_limits<Real>::max();
+
+    for (int tmp_facet = 0; tmp_facet < 3; ++tmp_facet)
+    {
+        if (ind_pt[tmp_facet] == ind_loop[tmp_facet]) continue;
+
+        Real facet_normal[3] = {0.0, 0.0, 0.0};
+        facet_normal[tmp_facet] = 1.0;
+
+        // skip cases where cell faces coincide with the eb facets
+        if (std::abs(eb_normal[0]) == facet_normal[0] &&
+            std::abs(eb_normal[1]) == facet_normal[1] &&
+            std::abs(eb_normal[2]) == facet_normal[2]) continue;
+
+        const int ind_cell = ind_loop[tmp_facet];
+        const int ind_nb   = ind_pt[tmp_facet];
+
+        const Real f_c = (ind_cell < ind_nb)
+            ? (static_cast<Real>(ind_cell) + 1.0) * m_dx_eb[tmp_facet]
+            :  static_cast<Real>(ind_cell)        * m_dx_eb[tmp_facet];
+
+        Real facet_p0[3];
+        for (int d = 0; d < 3; ++d) {
+            facet_p0[d] = (static_cast<Real>(ind_loop[d]) + 0.5) * m_dx_eb[d];
+        }
+        facet_p0[tmp_facet] = f_c;
+
+        const Real facet_h = dot3(facet_normal, facet_p0);
+
+        Real edge_p0[3], edge_v[3];
+        calc_facet_edge(edge_p0, edge_v, eb_h, facet_h, eb_normal, facet_normal);
+
+        const Real c[3] = {edge_p0[0]-r_vec[0], edge_p0[1]-r_vec[1], edge_p0[2]-r_vec[2]};
+        Real lambda_tmp = - dot3(edge_v, c) / dot3(edge_v, edge_v);
+
+        Real lambda_min, lambda_max;
+        lambda_bounds(lambda_min, lambda_max, ind_loop, edge_p0, edge_v, m_dx_eb);
+
+        if (lambda_tmp < lambda_min) {
+            lambda_tmp = lambda_min;
+        } else if (lambda_tmp > lambda_max) {
+            lambda_tmp = lambda_max;
+        }
+
+        Real c_vec_tmp[3], rc_vec[3];
+        for (int d = 0; d < 3; ++d) {
+            c_vec_tmp[d] = edge_p0[d] + lambda_tmp*edge_v[d];
+            rc_vec[d]    = c_vec_tmp[d] - r_vec[d];
+        }
+
+        const Real min_dist_tmp = dot3(rc_vec, rc_vec);
+        if (min_dist_tmp < min_dist) {
+            min_dist = min_dist_tmp;
+            for (int d = 0; d < 3; ++d) c_vec[d] = c_vec_tmp[d];
+        }
+    }
+
+    const Real rc[3] = {c_vec[0]-r_vec[0], c_vec[1]-r_vec[1], c_vec[2]-r_vec[2]};
+    return dot3(rc, rc);
+}
+
+void
+EBFacetGrid::closest_dist (Real& min_dist, bool& proj_valid, const Real* pos) const noexcept
+{
+    Real min_dist2;
+    const int i_nearest = nearest(pos, min_dist2);
+
+    proj_valid = false;
+    if (i_nearest < 0) {
+        min_dist = std::numeric_limits<Real>::max();
+        return;
+    }
+
+    // Test if pos "projects onto" the nearest EB facet's interior
+    const Real* eb_cent = &m_facets[6*i_nearest];
+    const Real* eb_norm = eb_cent + 3;
+
+    const Real r[3] = {pos[0]-eb_cent[0], pos[1]-eb_cent[1], pos[2]-eb_cent[2]};
+    const Real dist_proj = - dot3(r, eb_norm);
+
+    Real inv_dx[3], eb_min_pt[3];
+    int vi_cent[3], vi_pt[3];
+    for (int d = 0; d < 3; ++d) {
+        inv_dx[d]    = 1.0 / m_dx_eb[d];
+        eb_min_pt[d] = pos[d] + eb_norm[d] * dist_proj;
+        vi_cent[d]   = static_cast<int>(std::floor(eb_cent[d] * inv_dx[d]));
+        vi_pt[d]     = static_cast<int>(std::floor(eb_min_pt[d] * inv_dx[d]));
+    }
+
+    bool min_pt_valid = (vi_pt[0] == vi_cent[0] && vi_pt[1] == vi_cent[1] && vi_pt[2] == vi_cent[2]);
+    if (! min_pt_valid) {
+        // rounding error might give false negatives
+        for (int k_shift = -1; k_shift <= 1; ++k_shift) {
+        for (int j_shift = -1; j_shift <= 1; ++j_shift) {
+        for (int i_shift = -1; i_shift <= 1; ++i_shift) {
+            const int shift[3] = {i_shift, j_shift, k_shift};
+            for (int d = 0; d < 3; ++d) {
+                vi_pt[d] = static_cast<int>(std::floor((eb_min_pt[d] + shift[d]*1.e-6*m_dx_eb[d])
+                                                       * inv_dx[d]));
+            }
+            if (vi_pt[0] == vi_cent[0] && vi_pt[1] == vi_cent[1] && vi_pt[2] == vi_cent[2]) {
+                min_pt_valid = true;
+            }
+        }}}
+    }
+
+    if (min_pt_valid) {
+        // this is a signed distance function
+        min_dist   = dist_proj;
+        proj_valid = true;
+    } else {
+        // fallback: find the nearest point on the EB edge
+        const Real min_edge_dist2 = nearest_edge_dist2(vi_pt, vi_cent, pos, eb_norm, eb_cent);
+        min_dist = - std::sqrt(std::min(min_dist2, min_edge_dist2));
+    }
+}
+
+void
+EBFacetGrid::fill_levelset (const Box& bx, Array4<int> const& valid, Array4<Real> const& phi,
+                            const RealVect& dx) const noexcept
+{
+    const auto lo = amrex::lbound(bx);
+    const auto hi = amrex::ubound(bx);
+    const Real dx3[3] = {AMREX_D_DECL(dx[0], dx[1], dx[2])};
+
+    for         (int k = lo.z; k <= hi.z; ++k) {
+        for     (int j = lo.y; j <= hi.y; ++j) {
+            for (int i = lo.x; i <= hi.x; ++i) {
+                const Real pos[3] = {i*dx3[0], j*dx3[1], k*dx3[2]};
+                bool proj_valid;
+                closest_dist(phi(i,j,k), proj_valid, pos);
+                valid(i,j,k) = proj_valid ? 1 : 0;
+            }
+        }
+    }
+}
+
+void
+EBFacetGrid::fill_levelset_loc (const Box& bx, Array4<int> const& valid, Array4<Real> const& phi,
+                                Array4<Real const> const& ls_guess, Real ls_thres,
+                                const RealVect& dx) const noexcept
+{
+    const auto lo = amrex::lbound(bx);
+    const auto hi = amrex::ubound(bx);
+    const Real dx3[3] = {AMREX_D_DECL(dx[0], dx[1], dx[2])};
+
+    const Real phi_th = (ls_thres < 0.0) ? std::numeric_limits<Real>::max() : ls_thres;
+
+    for         (int k = lo.z; k <= hi.z; ++k) {
+        for     (int j = lo.y; j <= hi.y; ++j) {
+            for (int i = lo.x; i <= hi.x; ++i) {
+                if (std::abs(ls_guess(i,j,k)) < phi_th) {
+                    const Real pos[3] = {i*dx3[0], j*dx3[1], k*dx3[2]};
+                    bool proj_valid;
+                    closest_dist(phi(i,j,k), proj_valid, pos);
+                    valid(i,j,k) = proj_valid ? 1 : 0;
+                } else if (ls_guess(i,j,k) <= -phi_th) {
+                    phi(i,j,k)   = -phi_th;
+                    valid(i,j,k) = 0;
+                } else if (ls_guess(i,j,k) >= phi_th) {
+                    phi(i,j,k)   = phi_th;
+                    valid(i,j,k) = 0;
+                }
+            }
+        }
+    }
+}
+
+
+void
+EBFacetGridCache::begin (const void* eb_level, const RealVect& dx_eb)
+{
+    if (eb_level != m_eb_level || dx_eb != m_dx_eb) {
+        clear();
+        m_eb_level = eb_level;
+        m_dx_eb = dx_eb;
+    }
+    ++m_generation;
+}
+
+void
+EBFacetGridCache::end ()
+{
+    for (auto it = m_grids.begin(); it != m_grids.end(); ) {
+        if (it->second.used != m_generation) {
+            it = m_grids.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void
+EBFacetGridCache::clear ()
+{
+    m_grids.clear();
+    m_eb_level = nullptr;
+}
+
+std::shared_ptr<const EBFacetGrid>
+EBFacetGridCache::get (const Box& eb_search)
+{
+    std::shared_ptr<const EBFacetGrid> r;
+#ifdef _OPENMP
+#pragma omp critical (amrex_ebfacetgridcache)
+#endif
+    {
+        auto it = m_grids.find(eb_search);
+        if (it != m_grids.end()) {
+            it->second.used = m_generation;
+            r = it->second.grid;
+        }
+    }
+    return r;
+}
+
+void
+EBFacetGridCache::put (const Box& eb_search, const std::shared_ptr<const EBFacetGrid>& grid)
+{
+#ifdef _OPENMP
+#pragma omp critical (amrex_ebfacetgridcache)
+#endif
+    {
+        Entry& e = m_grids[eb_search];
+        e.grid = grid;
+        e.used = m_generation;
+    }
+}
+
+}
@@ -11,6 +11,7 @@
 #include <AMReX_EB_utils.H>
 #include <AMReX_EBAmrUtil.H>
 #include <AMReX_EB_F.H>
+#include <AMReX_EB_FacetGrid.H>
 
 #ifdef BL_USE_SENSEI_INSITU
 #include <AMReX_AmrMeshInSituBridge.H>
@@ -600,12 +601,12 @@ void LSCoreBase::FillLevelSet( MultiFab & level_set, const MultiFab & ls_crse,
                                  facet_list.dataPtr(), & facet_list_size,
                                  geom.CellSize()                          );
 
-                amrex_eb_fill_levelset_loc(BL_TO_FORTRAN_BOX(tile_box),
-                                           facet_list.dataPtr(), & facet_list_size,
-                                           BL_TO_FORTRAN_3D(v_tile),
-                                           BL_TO_FORTRAN_3D(ls_tile_w),
-                                           BL_TO_FORTRAN_3D(ls_tile), & ls_threshold,
-                                           geom.CellSize(), geom.CellSize()         );
+                const RealVect dx(AMREX_D_DECL(geom.CellSize(0),
+                                               geom.CellSize(1),
+                                               geom.CellSize(2)));
+                EBFacetGrid facet_grid(std::move(facet_list), dx);
+                facet_grid.fill_levelset_loc(tile_box, v_tile.array(), ls_tile_w.array(),
+                                             ls_tile.const_array(), ls_threshold, dx);
 
             }
 
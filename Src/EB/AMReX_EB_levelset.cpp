@@ -533,13 +533,14 @@ void LSFactory::fill_data (MultiFab & data, iMultiFab & valid,
                            const EBFArrayBoxFactory & eb_factory,
                            const MultiFab & eb_impfunc,
                            int ebt_size, int ls_ref, int eb_ref,
-                           const Geometry & geom, const Geometry & geom_eb) {
+                           const Geometry & geom, const Geometry & geom_eb,
+                           EBFacetGridCache * facet_cache) {
 
     // No profiling in function specialization
 
     LSFactory::fill_data(data, valid, eb_factory, eb_impfunc,
                          IntVect{AMREX_D_DECL(ebt_size, ebt_size, ebt_size)},
-                         ls_ref, eb_ref, geom, geom_eb);
+                         ls_ref, eb_ref, geom, geom_eb, facet_cache);
 }
 
 
@@ -548,7 +549,8 @@ void LSFactory::fill_data (MultiFab & data, iMultiFab & valid,
                            const EBFArrayBoxFactory & eb_factory,
                            const MultiFab & eb_impfunc,
                            const IntVect & ebt_size, int ls_ref, int eb_ref,
-                           const Geometry & geom, const Geometry & geom_eb) {
+                           const Geometry & geom, const Geometry & geom_eb,
+                           EBFacetGridCache * facet_cache) {
 
     BL_PROFILE("LSFactory::fill_data()");
 
@@ -626,6 +628,8 @@ void LSFactory::fill_data (MultiFab & data, iMultiFab & valid,
 
     const Real min_dx = LSUtility::min_dx(geom_eb);
 
+    if (facet_cache) facet_cache->begin(eb_factory.getEBLevel(), dx_eb);
+
 
     /****************************************************************************
      *                                                                          *
@@ -688,21 +692,22 @@ void LSFactory::fill_data (MultiFab & data, iMultiFab & valid,
 
 
         //_______________________________________________________________________
-        // Construct EB facets
-        std::unique_ptr<Vector<Real>> facets = eb_facets(norm_tile, bcent_tile, flag,
-                                                         dx_eb, eb_search);
-        int len_facets = facets->size();
+        // Construct EB facets, and bucket them for the nearest-facet search
+        std::shared_ptr<const EBFacetGrid> facet_grid;
+        if (facet_cache) facet_grid = facet_cache->get(eb_search);
+        if (! facet_grid) {
+            std::unique_ptr<Vector<Real>> facets = eb_facets(norm_tile, bcent_tile, flag,
+                                                             dx_eb, eb_search);
+            facet_grid = std::make_shared<const EBFacetGrid>(std::move(* facets), dx_eb);
+            if (facet_cache) facet_cache->put(eb_search, facet_grid);
+        }
 
 
         //_______________________________________________________________________
         // Fill local level-set
-        if (len_facets > 0) {
+        if (facet_grid->size() > 0) {
 
-            amrex_eb_fill_levelset(BL_TO_FORTRAN_BOX(tile_box),
-                                   facets->dataPtr(), & len_facets,
-                                   BL_TO_FORTRAN_3D(v_tile),
-                                   BL_TO_FORTRAN_3D(ls_tile),
-                                   dx.dataPtr(), dx_eb.dataPtr() );
+            facet_grid->fill_levelset(tile_box, v_tile.array(), ls_tile.array(), dx);
 
             region_tile.setVal<RunOn::Host>(1);
         } else {
@@ -726,6 +731,8 @@ void LSFactory::fill_data (MultiFab & data, iMultiFab & valid,
                                    BL_TO_FORTRAN_3D(v_tile),
                                    BL_TO_FORTRAN_3D(ls_tile)   );
     }
+
+    if (facet_cache) facet_cache->end();
 }
 
 
@@ -904,7 +911,8 @@ std::unique_ptr<iMultiFab> LSFactory::Fill(const EBFArrayBoxFactory & eb_factory
 
 
     LSFactory::fill_data(* ls_grid, * region_valid, eb_factory, mf_impfunc,
-                         ebt_size, ls_grid_ref, eb_grid_ref, geom_ls, geom_eb);
+                         ebt_size, ls_grid_ref, eb_grid_ref, geom_ls, geom_eb,
+                         & facet_cache);
 
 
     fill_valid();
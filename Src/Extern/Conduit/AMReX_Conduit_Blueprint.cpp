@@ -12,6 +12,10 @@
 #include <conduit/conduit_relay.hpp>
 using namespace conduit;
 
+#include <list>
+#include <memory>
+#include <mutex>
+
 namespace amrex {
 
 //---------------------------------------------------------------------------//
@@ -19,8 +23,8 @@ namespace amrex {
 //---------------------------------------------------------------------------//
 bool Nestsets(const int level,
               const int n_levels,
-              const FArrayBox &fab,
-              const Vector<const BoxArray*> box_arrays,
+              const Box &box,
+              const Vector<BoxArray> &box_arrays,
               const Vector<IntVect> &ref_ratio,
               const Vector<int> &domain_offsets,
               conduit::Node &nestset)
@@ -30,14 +34,13 @@ bool Nestsets(const int level,
     nestset["topology"] = "topo";
 
     const int dims = BL_SPACEDIM;
-    const Box &box = fab.box();
 
     bool valid = false;
     if(level > 0)
     {
       // check for parents
       std::vector<std::pair<int,Box> > isects
-        = box_arrays[level-1]->intersections(amrex::coarsen(box, ref_ratio[level-1]));
+        = box_arrays[level-1].intersections(amrex::coarsen(box, ref_ratio[level-1]));
 
       for(int b = 0; b < isects.size(); ++b)
       {
@@ -81,7 +84,7 @@ bool Nestsets(const int level,
     {
       // check for children
       std::vector<std::pair<int,Box> > isects
-        = box_arrays[level+1]->intersections(amrex::refine(box, ref_ratio[level]));
+        = box_arrays[level+1].intersections(amrex::refine(box, ref_ratio[level]));
 
       for(int b = 0; b < isects.size(); ++b)
       {
@@ -113,11 +116,11 @@ bool Nestsets(const int level,
         {
             window["dims/k"] = overlap.size()[2];
         }
-        window["ratio/i"] = ref_ratio[level+1][0];
-        window["ratio/j"] = ref_ratio[level+1][1];
+        window["ratio/i"] = ref_ratio[level][0];
+        window["ratio/j"] = ref_ratio[level][1];
         if(dims == 3)
         {
-            window["ratio/k"] = ref_ratio[level+1][2];
+            window["ratio/k"] = ref_ratio[level][2];
         }
       }
     }
@@ -125,99 +128,106 @@ bool Nestsets(const int level,
 }
 
 //---------------------------------------------------------------------------//
-// Creates a Rectilinear Blueprint Topology from the Geom and Fab.
+// Creates a Uniform Blueprint Topology from the Geom and a Box.
+//
+// The elements of the topology are the cells of the box.  For a box that is
+// nodal in some directions (e.g., faces), they are the dual cells centered
+// on the nodes, so that the data of the box are element associated.
 //---------------------------------------------------------------------------//
-void FabToBlueprintTopology(const Geometry& geom,
-                            const FArrayBox& fab,
+void BoxToBlueprintTopology(const Geometry& geom,
+                            const Box& box,
+                            const std::string& topo_name,
                             Node &res)
 {
     int dims = BL_SPACEDIM;
 
-    // get the details of the entire level from geom
-    amrex::Box level_box = geom.Domain();
-
-    int level_nx = level_box.size()[0];
-    int level_ny = level_box.size()[1];
-    int level_nz = dims > 2 ? level_box.size()[2] : 0;
-
     float64 level_x_min = geom.ProbLo(0);
-    float64 level_x_max = geom.ProbHi(0);
-
     float64 level_y_min = geom.ProbLo(1);
-    float64 level_y_max = geom.ProbHi(1);
-
     float64 level_z_min = dims > 2 ? geom.ProbLo(2) : 0;
-    float64 level_z_max = dims > 2 ? geom.ProbHi(2) : 0;
 
-    // geom.CellSize()[i] == (level_x_max - level_x_min) / float64(level_nx);
     float64 level_dx = geom.CellSize()[0];
-
-    // geom.CellSize()[j] == (level_y_max - level_y_min) / float64(level_ny);
     float64 level_dy = geom.CellSize()[1];
-
-    // geom.CellSize()[k] == (level_z_max - level_z_min) / float64(level_nz)
     float64 level_dz = dims > 2 ? geom.CellSize()[2] : 0.0;
 
-    // now extract the FAB details
-    const amrex::Box &fab_box = fab.box();
-
+    // shift of the element lower corners in nodal directions
+    const IndexType ixt = box.ixType();
+    float64 x_shift = ixt.nodeCentered(0) ? 0.5 : 0.0;
+    float64 y_shift = ixt.nodeCentered(1) ? 0.5 : 0.0;
+    float64 z_shift = (dims > 2 && ixt.nodeCentered(dims-1)) ? 0.5 : 0.0;
 
-    int i_min = fab_box.smallEnd(0);
-    int i_max = fab_box.bigEnd(0);
+    int i_min = box.smallEnd(0);
+    int i_max = box.bigEnd(0);
 
-    int j_min = fab_box.smallEnd(1);
-    int j_max = fab_box.bigEnd(1);
-
-    int k_min = dims > 2 ? fab_box.smallEnd(2) : 0;
-    int k_max = dims > 2 ? fab_box.bigEnd(2) : 0;
+    int j_min = box.smallEnd(1);
+    int j_max = box.bigEnd(1);
 
+    int k_min = dims > 2 ? box.smallEnd(dims-1) : 0;
+    int k_max = dims > 2 ? box.bigEnd(dims-1) : 0;
 
     int nx = (i_max - i_min + 1);
     int ny = (j_max - j_min + 1);
     int nz = dims > 2 ? (k_max - k_min +1) : 1;
 
-    float64 x_min = level_x_min + level_dx * i_min;
-    float64 x_max = level_x_min + level_dx * i_max;
+    float64 x_min = level_x_min + level_dx * (i_min - x_shift);
+    float64 y_min = level_y_min + level_dy * (j_min - y_shift);
+    float64 z_min = dims > 2 ? level_z_min + level_dz * (k_min - z_shift) : 0.0;
 
-    float64 y_min = level_y_min + level_dy * j_min;
-    float64 y_max = level_y_min + level_dy * j_max;
-
-    float64 z_min = dims > 2 ? level_z_min + level_dz * k_min : 0.0;
-    float64 z_max = dims > 2 ? level_z_min + level_dz * k_max : 0.0;
+    const std::string coords_name = "coords" + topo_name.substr(4);
 
     // create uniform coordset
     // (which also holds all implicit details needed for the topology)
-    res["coordsets/coords/type"] = "uniform";
-    res["coordsets/coords/dims/i"] = nx+1;
-    res["coordsets/coords/dims/j"] = ny+1;
+    Node &n_coords = res["coordsets/"+coords_name];
+    n_coords["type"] = "uniform";
+    n_coords["dims/i"] = nx+1;
+    n_coords["dims/j"] = ny+1;
 
-    res["coordsets/coords/spacing/dx"] = level_dx;
-    res["coordsets/coords/spacing/dy"] = level_dy;
+    n_coords["spacing/dx"] = level_dx;
+    n_coords["spacing/dy"] = level_dy;
 
-    res["coordsets/coords/origin/x"] = x_min;
-    res["coordsets/coords/origin/y"] = y_min;
+    n_coords["origin/x"] = x_min;
+    n_coords["origin/y"] = y_min;
 
     if(dims > 2)
     {
-      res["coordsets/coords/dims/k"] = nz+1;
-      res["coordsets/coords/spacing/dz"] = level_dz;
-      res["coordsets/coords/origin/z"] = z_min;
+      n_coords["dims/k"] = nz+1;
+      n_coords["spacing/dz"] = level_dz;
+      n_coords["origin/z"] = z_min;
     }
 
-    // create a rectilinear topology that refs our coordset
-    res["topologies/topo/type"] = "uniform";
-    res["topologies/topo/coordset"] = "coords";
+    // create a uniform topology that refs our coordset
+    Node &n_topo = res["topologies/"+topo_name];
+    n_topo["type"] = "uniform";
+    n_topo["coordset"] = coords_name;
 
     // add logical elements origin
-    res["topologies/topo/elements/origin/i0"] = i_min;
-    res["topologies/topo/elements/origin/j0"] = j_min;
+    n_topo["elements/origin/i0"] = i_min;
+    n_topo["elements/origin/j0"] = j_min;
     if( dims > 2)
     {
-        res["topologies/topo/elements/origin/k0"] = k_min;
+        n_topo["elements/origin/k0"] = k_min;
     }
 
 }
 
+//---------------------------------------------------------------------------//
+// Name of the topology for data of the given index type.  Cell-centered
+// and nodal data live on "topo", other data on their own dual topology,
+// e.g., "topo_ncc" for x-faces in 3D.
+//---------------------------------------------------------------------------//
+std::string BlueprintTopologyName(const IndexType& ixt)
+{
+    if(ixt.cellCentered() || ixt.nodeCentered())
+    {
+        return "topo";
+    }
+    std::string r("topo_");
+    for(int d = 0; d < BL_SPACEDIM; d++)
+    {
+        r += ixt.nodeCentered(d) ? 'n' : 'c';
+    }
+    return r;
+}
+
 //---------------------------------------------------------------------------//
 // Creates a Blueprint Field that identifies the cells in the ghost or "grow"
 // region of the fab.
@@ -227,21 +237,18 @@ void FabToBlueprintTopology(const Geometry& geom,
 //    1 = ghost cell
 //
 //---------------------------------------------------------------------------//
-void AddFabGhostIndicatorField (const FArrayBox& fab,
-                                int ngrow,
-                                Node &res)
+void AddGhostIndicatorField (const Box& fab_box,
+                             int ngrow,
+                             Node &res)
 {
     Node &n_field = res["fields/ghost_indicator"];
     n_field["association"] = "element";
     n_field["topology"] = "topo";
-    n_field["values"].set(DataType::float64(fab.box().numPts()));
+    n_field["values"].set(DataType::float64(fab_box.numPts()));
     float64_array vals_array = n_field["values"].value();
 
     int dims = BL_SPACEDIM;
 
-    // find the FAB details
-    const amrex::Box &fab_box = fab.box();
-
     int i_min = fab_box.smallEnd(0);
     int i_max = fab_box.bigEnd(0);
 
@@ -287,14 +294,19 @@ void FabToBlueprintFields (const FArrayBox& fab,
                            Node &res)
 {
     // make sure we are not asking for more components than exist.
-    BL_ASSERT(varnames.size() <= fab->nComp());
+    BL_ASSERT(varnames.size() <= fab.nComp());
+
+    // nodal data are the vertices of the cell topology, all other data
+    // are the elements of their topology
+    const IndexType ixt = fab.box().ixType();
+    const bool nodal = ixt.nodeCentered();
 
     Node &n_fields = res["fields"];
     for(int i=0; i < varnames.size(); i++)
     {
         Node &n_field = n_fields[varnames[i]];
-        n_field["association"] = "element";
-        n_field["topology"] = "topo";
+        n_field["association"] = nodal ? "vertex" : "element";
+        n_field["topology"] = BlueprintTopologyName(ixt);
         //
         // const_cast is used b/c zero copy via Node::set_external
         // requires non-const
@@ -306,6 +318,199 @@ void FabToBlueprintFields (const FArrayBox& fab,
     }
 }
 
+//---------------------------------------------------------------------------//
+// Cache of the parts of a Blueprint mesh that only depend on the grids:
+// the coordsets, topologies, nesting sets and ghost indicators of the local
+// patches.  They are built the first time a hierarchy is seen and reused
+// until the grids change, so that the nesting sets are not recomputed and
+// the ghost indicators are not recomputed on every call.
+//
+// An entry holds copies of the BoxArrays and DistributionMappings, which
+// keeps their references alive, so a new BoxArray can never be mistaken
+// for a cached one.  The returned Nodes zero copy the ghost indicators of
+// the entry, so an entry is only evicted once no MultiFab uses its
+// DistributionMappings, i.e., once the field data of the Nodes are gone too.
+//---------------------------------------------------------------------------//
+namespace {
+
+struct BlueprintMeshCache
+{
+    Vector<BoxArray> box_arrays;
+    Vector<DistributionMapping> dmaps;
+    Vector<Box> domains;
+    Vector<RealBox> prob_domains;
+    Vector<IntVect> ref_ratio;
+    Vector<int> ngrow;
+    Node patches;
+};
+
+std::list<std::shared_ptr<const BlueprintMeshCache> > blueprint_mesh_cache;
+bool blueprint_mesh_cache_registered = false;
+std::mutex blueprint_mesh_cache_mutex;
+
+bool CacheMatches (const BlueprintMeshCache& c,
+                   int n_levels,
+                   const Vector<const MultiFab*>& mfs,
+                   const Vector<Geometry>& geoms,
+                   const Vector<IntVect>& ref_ratio)
+{
+    if(c.box_arrays.size() != n_levels) return false;
+    for(int i = 0; i < n_levels; i++)
+    {
+        if(c.box_arrays[i] != mfs[i]->boxArray() ||
+           c.dmaps[i] != mfs[i]->DistributionMap() ||
+           c.domains[i] != geoms[i].Domain() ||
+           c.ngrow[i] != mfs[i]->nGrow())
+        {
+            return false;
+        }
+        for(int d = 0; d < BL_SPACEDIM; d++)
+        {
+            if(c.prob_domains[i].lo(d) != geoms[i].ProbLo(d) ||
+               c.prob_domains[i].hi(d) != geoms[i].ProbHi(d))
+            {
+                return false;
+            }
+        }
+        if(i < n_levels-1 && c.ref_ratio[i] != ref_ratio[i]) return false;
+    }
+    return true;
+}
+
+// Whether a MultiFab still uses the grids of the entry.
+bool CacheInUse (const BlueprintMeshCache& c)
+{
+    for(int i = 0; i < c.dmaps.size(); i++)
+    {
+        // the references held by the entry itself
+        Long nrefs = 0;
+        for(int j = 0; j < c.dmaps.size(); j++)
+        {
+            if(c.dmaps[j].getRefID() == c.dmaps[i].getRefID()) nrefs++;
+        }
+        if(c.dmaps[i].linkCount() > nrefs) return true;
+    }
+    return false;
+}
+
+void FreeBlueprintMeshCache ()
+{
+    std::lock_guard<std::mutex> lock(blueprint_mesh_cache_mutex);
+    blueprint_mesh_cache.clear();
+    blueprint_mesh_cache_registered = false;
+}
+
+//---------------------------------------------------------------------------//
+// Returns the cached patches for the hierarchy, building them if needed.
+//---------------------------------------------------------------------------//
+std::shared_ptr<const BlueprintMeshCache>
+GetBlueprintMeshCache (int n_levels,
+                       const Vector<const MultiFab*>& mfs,
+                       const Vector<Geometry>& geoms,
+                       const Vector<IntVect>& ref_ratio)
+{
+    std::lock_guard<std::mutex> lock(blueprint_mesh_cache_mutex);
+
+    for(auto it = blueprint_mesh_cache.begin(); it != blueprint_mesh_cache.end(); ++it)
+    {
+        if(CacheMatches(**it, n_levels, mfs, geoms, ref_ratio))
+        {
+            // most recently used first
+            blueprint_mesh_cache.splice(blueprint_mesh_cache.begin(),
+                                        blueprint_mesh_cache, it);
+            return blueprint_mesh_cache.front();
+        }
+    }
+
+    BL_PROFILE("BlueprintMeshCache::build()");
+
+    if(!blueprint_mesh_cache_registered)
+    {
+        amrex::ExecOnFinalize(FreeBlueprintMeshCache);
+        blueprint_mesh_cache_registered = true;
+    }
+    blueprint_mesh_cache.remove_if(
+        [] (const std::shared_ptr<const BlueprintMeshCache>& p)
+        { return !CacheInUse(*p); });
+    std::shared_ptr<BlueprintMeshCache> cp = std::make_shared<BlueprintMeshCache>();
+    BlueprintMeshCache& c = *cp;
+
+    // nesting is done on the cells, whatever the type of the data
+    Vector<BoxArray> cell_box_arrays;
+    Vector<int> box_offsets;
+    for(int i = 0; i < n_levels; i++)
+    {
+        c.box_arrays.push_back(mfs[i]->boxArray());
+        c.dmaps.push_back(mfs[i]->DistributionMap());
+        c.domains.push_back(geoms[i].Domain());
+        c.prob_domains.push_back(geoms[i].ProbDomain());
+        c.ngrow.push_back(mfs[i]->nGrow());
+        if(i < n_levels-1) c.ref_ratio.push_back(ref_ratio[i]);
+
+        cell_box_arrays.push_back(amrex::convert(mfs[i]->boxArray(),
+                                                 IndexType::TheCellType()));
+        if(i == 0)
+        {
+          box_offsets.push_back(0);
+        }
+        else
+        {
+          box_offsets.push_back(box_offsets[i-1] + mfs[i-1]->size());
+        }
+    }
+
+    for(int i = 0; i < n_levels; i++)
+    {
+        const Geometry &geom = geoms[i];
+        const MultiFab &mf = *mfs[i];
+        const int ngrow = mf.nGrow();
+        const std::string topo_name = BlueprintTopologyName(mf.ixType());
+
+        for(MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            int domain_id = mfi.index() + box_offsets[i];
+            const std::string& patch_name = amrex::Concatenate("domain_",
+                                                               domain_id,
+                                                               6);
+            Node &patch = c.patches[patch_name];
+
+            const Box& fab_box = mfi.fabbox();
+            const Box& cell_box = amrex::enclosedCells(fab_box);
+
+            // create coordset and topo on the cells, and a dual
+            // topology for data that are neither cell-centered nor nodal
+            BoxToBlueprintTopology(geom, cell_box, "topo", patch);
+            if(topo_name != "topo")
+            {
+                BoxToBlueprintTopology(geom, fab_box, topo_name, patch);
+            }
+
+            // add the nesting relationship
+            if(n_levels > 1)
+            {
+                conduit::Node nestset;
+                bool valid = Nestsets(i, n_levels, cell_box, cell_box_arrays,
+                                      ref_ratio, box_offsets, nestset);
+                if(valid)
+                {
+                    patch["nestsets/nest"].set(nestset);
+                }
+            }
+
+            // add ghost indicator if the fab has ghost cells
+            if(ngrow > 0)
+            {
+                AddGhostIndicatorField(cell_box, ngrow, patch);
+            }
+        }
+    }
+
+    blueprint_mesh_cache.push_front(cp);
+    return cp;
+}
+
+}
+
 //---------------------------------------------------------------------------//
 // Converts a single level AMReX mesh into a Conduit Mesh Blueprint Hierarchy.
 //---------------------------------------------------------------------------//
@@ -355,32 +560,13 @@ MultiLevelToBlueprint (int n_levels,
     BL_ASSERT(n_levels <= level_steps.size());
     BL_ASSERT(mfs[0]->nComp() == varnames.size());
 
-    int finest_level = n_levels-1;
-
-    int num_levels = geoms.size();
-
-    // get mpi rank and # of tasks
-    int rank   = ParallelDescriptor::MyProc();
-    int ntasks = ParallelDescriptor::NProcs();
-
-    Vector<const BoxArray*> box_arrays;
-    Vector<int> box_offsets;
-    for(int i = 0; i < num_levels; i++)
-    {
-      const BoxArray &boxs = mfs[i]->boxArray();
-      box_arrays.push_back(&boxs);
-      if(i == 0)
-      {
-        box_offsets.push_back(0);
-      }
-      else
-      {
-        box_offsets[i] = box_offsets[i-1] + mfs[i]->size();
-      }
-    }
+    // the grid dependent parts of the patches, kept alive until we are done
+    std::shared_ptr<const BlueprintMeshCache> cache =
+        GetBlueprintMeshCache(n_levels, mfs, geoms, ref_ratio);
+    const Node &cached = cache->patches;
 
     int num_domains = 0;
-    for(int i = 0; i < num_levels; i++)
+    for(int i = 0; i < n_levels; i++)
     {
         //
         // Geometry represents the physical and logical space of an entire level.
@@ -389,12 +575,8 @@ MultiLevelToBlueprint (int n_levels,
         // In Blueprint speak, Each Multifab contains several domains and
         // each fab has "components" which map to a Blueprint field.
 
-        const Geometry &geom = geoms[i];
         const MultiFab &mf = *mfs[i];
 
-        // ngrow tells us how many layers of ghosts
-        int ngrow = mf.nGrow();
-
         // mfiter allows us to iterate over local patches
         for(MFIter mfi(mf); mfi.isValid(); ++mfi)
         {
@@ -410,28 +592,28 @@ MultiLevelToBlueprint (int n_levels,
             patch["state/cycle"] = level_steps[0];
             patch["state/time"] = time_value;
 
-            const FArrayBox &fab = mf[mfi];
-
-            // create coordset and topo
-            FabToBlueprintTopology(geom,fab,patch);
-            // add the nesting relationship
-            if(num_levels > 1)
+            // the coordsets, topologies and nesting sets are copied from
+            // the cache, the ghost indicator is zero copied
+            const Node &cpatch = cached[patch_name];
+            patch["coordsets"].update(cpatch["coordsets"]);
+            patch["topologies"].update(cpatch["topologies"]);
+            if(cpatch.has_child("nestsets"))
             {
-                conduit::Node nestset;
-                bool valid = Nestsets(i, n_levels, fab, box_arrays, ref_ratio, box_offsets, nestset);
-                if(valid)
-                {
-                    patch["nestsets/nest"].set(nestset);
-                }
+                patch["nestsets"].update(cpatch["nestsets"]);
             }
-            // add fields
-            FabToBlueprintFields(fab,varnames,patch);
-
-            // add ghost indicator if the fab has ghost cells
-            if(ngrow > 0)
+            if(cpatch.has_path("fields/ghost_indicator"))
             {
-                AddFabGhostIndicatorField(fab,ngrow,patch);
+                const Node &c_ghost = cpatch["fields/ghost_indicator"];
+                Node &n_ghost = patch["fields/ghost_indicator"];
+                n_ghost["association"] = "element";
+                n_ghost["topology"] = "topo";
+                // const_cast b/c zero copy via Node::set_external
+                // requires non-const
+                n_ghost["values"].set_external(const_cast<Node&>(c_ghost["values"]));
             }
+
+            // add fields
+            FabToBlueprintFields(mf[mfi],varnames,patch);
         }
         num_domains += mf.size();
     }
@@ -17,6 +17,7 @@ using std::strlen;
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <cstdio>
 using std::ios;
 using std::ifstream;
@@ -106,6 +107,8 @@ namespace amrex {
 bool AmrData::verbose = false;
 int  AmrData::skipPltLines  = 0;
 int  AmrData::sBoundaryWidth = 0;
+bool AmrData::sLazyLoading = false;
+Long AmrData::fabCacheTargetBytes = 1024L * 1024L * 1024L;
 
 // ---------------------------------------------------------------
 AmrData::AmrData() {
@@ -115,6 +118,8 @@ AmrData::AmrData() {
   plotVars.clear();
   nRegions = 0;
   boundaryWidth = 0;
+  bLazyLoading = false;
+  loadedFabBytes = 0;
 }
 
 
@@ -167,6 +172,7 @@ bool AmrData::ReadData(const string &filename, Amrvis::FileType filetype) {
    if(filetype == Amrvis::PROFDATA) {
       return false;    // ---- profdata will be handled later
    }
+   bLazyLoading = sLazyLoading;
 
    int i, j, k, width;
    fileName = filename;
@@ -183,25 +189,22 @@ bool AmrData::ReadData(const string &filename, Amrvis::FileType filetype) {
     File += "Header";
 #endif
 
-    VisMF::IO_Buffer io_buffer(VisMF::GetIOBufferSize());
-
-    ifstream isPltIn;
-
-    isPltIn.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
-
    if(verbose) {
      if(ParallelDescriptor::IOProcessor()) {
        cout << "AmrData::opening file = " << File << endl;
      }
    }
 
-   isPltIn.open(File.c_str(), ios::in);
-   if(isPltIn.fail()) {
+   // ---- the header is read once and broadcast
+   Vector<char> fileCharPtr;
+   ParallelDescriptor::ReadAndBcastFile(File, fileCharPtr, false);
+   if(fileCharPtr.empty()) {
      if(ParallelDescriptor::IOProcessor()) {
       cerr << "AmrData::Unable to open file:  " << File << endl;
      }
       return false;
    }
+   std::istringstream isPltIn(string(fileCharPtr.dataPtr()), std::istringstream::in);
 
    char skipBuff[Amrvis::LINELENGTH];
    for(i = 0; i < skipPltLines; ++i) {
@@ -797,7 +800,6 @@ bool AmrData::ReadData(const string &filename, Amrvis::FileType filetype) {
        }
      }
    }
-   isPltIn.close();
 
    return true;
 
@@ -1146,6 +1148,8 @@ void AmrData::FillVar(MultiFab &destMultiFab, int finestFillLevel,
     BL_ASSERT(varNames.size() == destFillComps.size());
     int nFillVars(varNames.size());
 
+    TrimFabCache();
+
   for(int currentFillIndex(0); currentFillIndex < nFillVars; ++currentFillIndex) {
     int destComp(destFillComps[currentFillIndex]);
     int stateIndex(StateNumber(varNames[currentFillIndex]));
@@ -1156,7 +1160,7 @@ void AmrData::FillVar(MultiFab &destMultiFab, int finestFillLevel,
         if(currentLevel != finestFillLevel) {
           tempCoarseBox.coarsen(cumulativeRefRatios[currentLevel]);
         }
-        GetGrids(currentLevel, stateIndex, tempCoarseBox);
+        LoadGrids(currentLevel, stateIndex, tempCoarseBox, false);
       }
     }
 
@@ -1379,6 +1383,8 @@ void AmrData::FillVar(Vector<FArrayBox *> &destFabs, const Vector<Box> &destBoxe
                                           refRatio[currentLevel];
     }
 
+    TrimFabCache();
+
     // ensure the required grids are in memory
     for(currentLevel = 0; currentLevel <= finestFillLevel; ++currentLevel) {
       for(int iBox = 0; iBox < destBoxes.size(); ++iBox) {
@@ -1386,7 +1392,7 @@ void AmrData::FillVar(Vector<FArrayBox *> &destFabs, const Vector<Box> &destBoxe
         if(currentLevel != finestFillLevel) {
           tempCoarseBox.coarsen(cumulativeRefRatios[currentLevel]);
         }
-        GetGrids(currentLevel, stateIndex, tempCoarseBox);
+        LoadGrids(currentLevel, stateIndex, tempCoarseBox, false);
       }
     }
 
@@ -1692,6 +1698,7 @@ int AmrData::FinestIntersectingLevel(const Box &b, int startLevel) const {
 MultiFab &AmrData::GetGrids(int level, int componentIndex) {
   for(MFIter mfi(*dataGrids[level][componentIndex]); mfi.isValid(); ++mfi) {
     DefineFab(level, componentIndex, mfi.index());
+    PinFab(level, componentIndex, mfi.index());
   }
   return *dataGrids[level][componentIndex];
 }
@@ -1699,6 +1706,16 @@ MultiFab &AmrData::GetGrids(int level, int componentIndex) {
 
 // ---------------------------------------------------------------
 MultiFab &AmrData::GetGrids(int level, int componentIndex, const Box &onBox) {
+  return LoadGrids(level, componentIndex, onBox, true);
+}
+
+
+// ---------------------------------------------------------------
+// read the fabs intersecting onBox.  FillVar uses this without pinning,
+// so the fabs it reads can be freed by a later TrimFabCache.
+MultiFab &AmrData::LoadGrids(int level, int componentIndex, const Box &onBox,
+                             bool pin)
+{
   if(fileType == Amrvis::FAB || (fileType == Amrvis::MULTIFAB && level == 0)) {
     // do nothing
   } else {
@@ -1707,7 +1724,14 @@ MultiFab &AmrData::GetGrids(int level, int componentIndex, const Box &onBox) {
         mfi.isValid(); ++mfi)
     {
       if(onBox.intersects(visMF[level][whichVisMF]->boxArray()[mfi.index()])) {
-        DefineFab(level, componentIndex, mfi.index());
+        if(bLazyLoading) {
+          DefineFab(level, componentIndex, mfi.index(), onBox);
+          if(pin) {
+            PinFab(level, componentIndex, mfi.index());
+          }
+        } else {
+          DefineFab(level, componentIndex, mfi.index());
+        }
       }
     }
   }
@@ -1718,6 +1742,10 @@ MultiFab &AmrData::GetGrids(int level, int componentIndex, const Box &onBox) {
 // ---------------------------------------------------------------
 bool AmrData::DefineFab(int level, int componentIndex, int fabIndex) {
 
+  if(bLazyLoading) {
+    return DefineFab(level, componentIndex, fabIndex,
+                     dataGrids[level][componentIndex]->fabbox(fabIndex));
+  }
   if( ! dataGridsDefined[level][componentIndex][fabIndex]) {
     int whichVisMF(compIndexToVisMFMap[componentIndex]);
     int whichVisMFComponent(compIndexToVisMFComponentMap[componentIndex]);
@@ -1729,6 +1757,117 @@ bool AmrData::DefineFab(int level, int componentIndex, int fabIndex) {
 }
 
 
+// ---------------------------------------------------------------
+// read the part of the fab on region that is not in memory yet.  the whole
+// fab is allocated so the copy descriptors in FillVar can use it as usual,
+// but only the bounding box of the missing parts is read from the file.
+bool AmrData::DefineFab(int level, int componentIndex, int fabIndex,
+                        const Box &region)
+{
+  if( ! bLazyLoading) {
+    return DefineFab(level, componentIndex, fabIndex);
+  }
+
+  MultiFab &mf = *dataGrids[level][componentIndex];
+  const Box fabBox(mf.fabbox(fabIndex));
+  const Box readBox(region & fabBox);
+  if( ! readBox.ok()) {
+    return false;
+  }
+
+  const std::array<int, 3> key = {{ level, componentIndex, fabIndex }};
+  std::map<std::array<int, 3>, LoadedFab>::iterator lfi = loadedFabs.find(key);
+  if(lfi == loadedFabs.end()) {
+    if(dataGridsDefined[level][componentIndex][fabIndex]) {  // evicted before
+      mf[fabIndex].resize(fabBox, 1);
+    } else {
+      mf.setFab(fabIndex, new FArrayBox(fabBox, 1));
+      dataGridsDefined[level][componentIndex][fabIndex] = true;
+    }
+    fabLRU.push_front(key);
+    LoadedFab lf;
+    lf.loaded = BoxList(fabBox.ixType());
+    lf.lru = fabLRU.begin();
+    lf.pinned = false;
+    lfi = loadedFabs.insert(std::make_pair(key, lf)).first;
+    loadedFabBytes += fabBox.numPts() * sizeof(Real);
+  } else if( ! lfi->second.pinned) {
+    fabLRU.splice(fabLRU.begin(), fabLRU, lfi->second.lru);
+  }
+
+  BoxList &loaded = lfi->second.loaded;
+  const BoxList missing(amrex::complementIn(readBox, loaded));
+  if(missing.isEmpty()) {
+    return true;
+  }
+
+  int whichVisMF(compIndexToVisMFMap[componentIndex]);
+  int whichVisMFComponent(compIndexToVisMFComponentMap[componentIndex]);
+  std::unique_ptr<FArrayBox> part(visMF[level][whichVisMF]->readFAB(fabIndex,
+                                  missing.minimalBox(), whichVisMFComponent, 1));
+  for(BoxList::const_iterator bli = missing.begin(); bli != missing.end(); ++bli) {
+    mf[fabIndex].copy<RunOn::Host>(*part, *bli, 0, *bli, 0, 1);
+    loaded.push_back(*bli);
+  }
+  Long nLoaded(0);
+  for(BoxList::const_iterator bli = loaded.begin(); bli != loaded.end(); ++bli) {
+    nLoaded += bli->numPts();
+  }
+  if(nLoaded == fabBox.numPts()) {
+    loaded.clear();
+    loaded.push_back(fabBox);
+  }
+  return true;
+}
+
+
+// ---------------------------------------------------------------
+// a fab returned by GetGrids may be used by the caller at any time, so it
+// is taken out of the lru list and only freed by FlushGrids.
+void AmrData::PinFab(int level, int componentIndex, int fabIndex) {
+  const std::array<int, 3> key = {{ level, componentIndex, fabIndex }};
+  std::map<std::array<int, 3>, LoadedFab>::iterator lfi = loadedFabs.find(key);
+  if(lfi != loadedFabs.end() && ! lfi->second.pinned) {
+    fabLRU.erase(lfi->second.lru);
+    lfi->second.pinned = true;
+  }
+}
+
+
+// ---------------------------------------------------------------
+// free the least recently used unpinned fabs until the cache is below
+// fabCacheTargetBytes.  this is only called before a fill, so the fabs of
+// one fill are never freed while they are used.
+void AmrData::TrimFabCache() {
+  while(loadedFabBytes > fabCacheTargetBytes && ! fabLRU.empty()) {
+    const std::array<int, 3> &key = fabLRU.back();
+    FArrayBox &fab = (*dataGrids[key[0]][key[1]])[key[2]];
+    loadedFabBytes -= fab.box().numPts() * sizeof(Real);
+    fab.clear();
+    loadedFabs.erase(key);
+    fabLRU.pop_back();
+  }
+}
+
+
+// ---------------------------------------------------------------
+void AmrData::FlushFabCache(int componentIndex) {
+  std::map<std::array<int, 3>, LoadedFab>::iterator lfi = loadedFabs.begin();
+  while(lfi != loadedFabs.end()) {
+    if(lfi->first[1] == componentIndex) {
+      const Box fabBox(dataGrids[lfi->first[0]][componentIndex]->fabbox(lfi->first[2]));
+      loadedFabBytes -= fabBox.numPts() * sizeof(Real);
+      if( ! lfi->second.pinned) {
+        fabLRU.erase(lfi->second.lru);
+      }
+      lfi = loadedFabs.erase(lfi);
+    } else {
+      ++lfi;
+    }
+  }
+}
+
+
 // ---------------------------------------------------------------
 void AmrData::FlushGrids() {
   for (int componentIndex(0); componentIndex < nComp; ++componentIndex) {
@@ -1744,6 +1883,7 @@ void AmrData::FlushGrids(int componentIndex) {
   Fab_noallocate.SetAlloc(false);
 
   BL_ASSERT(componentIndex < nComp);
+  FlushFabCache(componentIndex);
   for(int lev(0); lev <= finestLevel; ++lev) {
     if(dataGrids.size() > lev
        && dataGrids[lev].size() > componentIndex
@@ -1783,6 +1923,8 @@ bool AmrData::MinMax(const Box &onBox, const string &derived, int level,
 
   int compIndex(StateNumber(derived));
 
+  TrimFabCache();
+
   if(fileType == Amrvis::FAB || (fileType == Amrvis::MULTIFAB && level == 0)) {
     for(MFIter gpli(*dataGrids[level][compIndex]); gpli.isValid(); ++gpli) {
       if(onBox.intersects(dataGrids[level][compIndex]->boxArray()[gpli.index()])) {
@@ -1924,10 +2066,10 @@ bool AmrData::MinMax(const Box &onBox, const string &derived, int level,
 				 boxArray()[gpli.index()]))
       {
         if(visMFMin < dataMin || visMFMax > dataMax) {  // do it the hard way
-	  DefineFab(level, compIndex, gpli.index());
           valid = true;
           overlap = onBox;
           overlap &= gpli.validbox();
+	  DefineFab(level, compIndex, gpli.index(), overlap);
           minVal = (*dataGrids[level][compIndex])[gpli].min<RunOn::Host>(overlap, 0);
           maxVal = (*dataGrids[level][compIndex])[gpli].max<RunOn::Host>(overlap, 0);
 
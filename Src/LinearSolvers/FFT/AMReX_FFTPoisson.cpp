@@ -0,0 +1,524 @@
+
+#include <algorithm>
+#include <cmath>
+
+#include <AMReX_FFTPoisson.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_BoxIterator.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef AMREX_USE_FFTW
+#include <fftw3.h>
+#ifdef BL_USE_FLOAT
+#define AMREX_FFTW(x) fftwf_ ## x
+#else
+#define AMREX_FFTW(x) fftw_ ## x
+#endif
+#endif
+
+namespace amrex {
+
+class FFTPoisson::LineFFT
+{
+public:
+
+    explicit LineFFT (int n);
+    ~LineFFT ();
+
+    LineFFT (const LineFFT&) = delete;
+    LineFFT& operator= (const LineFFT&) = delete;
+
+    //! In-place unnormalized transform of x, which has length n.  work is
+    //! a scratch buffer, so that this can be called by several threads.
+    void operator() (std::complex<Real>* x, bool forward,
+                     Vector<std::complex<Real> >& work) const;
+
+private:
+
+    int m_n;
+
+#ifdef AMREX_USE_FFTW
+    AMREX_FFTW(plan) m_fwd;
+    AMREX_FFTW(plan) m_bwd;
+#else
+    //! Radix-2 transform of length m_m, in place.
+    void pow2 (std::complex<Real>* x, bool forward) const;
+
+    //! Length of the radix-2 transform: n if n is a power of 2, otherwise
+    //! the length of the convolution of Bluestein's algorithm.
+    int m_m;
+    Vector<std::complex<Real> > m_twiddle;
+    Vector<int> m_bitrev;
+    //! exp(-i pi k^2/n) and the transform of its conjugate for Bluestein's
+    //! algorithm.
+    Vector<std::complex<Real> > m_chirp;
+    Vector<std::complex<Real> > m_chirp_hat;
+#endif
+};
+
+#ifdef AMREX_USE_FFTW
+
+FFTPoisson::LineFFT::LineFFT (int n)
+    : m_n(n)
+{
+    auto buf = static_cast<AMREX_FFTW(complex)*>(AMREX_FFTW(malloc)(sizeof(AMREX_FFTW(complex))*n));
+    m_fwd = AMREX_FFTW(plan_dft_1d)(n, buf, buf, FFTW_FORWARD , FFTW_ESTIMATE | FFTW_UNALIGNED);
+    m_bwd = AMREX_FFTW(plan_dft_1d)(n, buf, buf, FFTW_BACKWARD, FFTW_ESTIMATE | FFTW_UNALIGNED);
+    AMREX_FFTW(free)(buf);
+}
+
+FFTPoisson::LineFFT::~LineFFT ()
+{
+    AMREX_FFTW(destroy_plan)(m_fwd);
+    AMREX_FFTW(destroy_plan)(m_bwd);
+}
+
+void
+FFTPoisson::LineFFT::operator() (std::complex<Real>* x, bool forward,
+                                 Vector<std::complex<Real> >& /*work*/) const
+{
+    auto p = reinterpret_cast<AMREX_FFTW(complex)*>(x);
+    AMREX_FFTW(execute_dft)(forward ? m_fwd : m_bwd, p, p);
+}
+
+#else
+
+FFTPoisson::LineFFT::LineFFT (int n)
+    : m_n(n)
+{
+    const bool is_pow2 = (n & (n-1)) == 0;
+    m_m = 1;
+    while (m_m < (is_pow2 ? n : 2*n-1)) m_m *= 2;
+
+    const double twopi = 2.0*3.14159265358979323846;
+
+    m_twiddle.resize(m_m/2);
+    for (int k = 0; k < m_m/2; ++k) {
+        const double t = -twopi*k/m_m;
+        m_twiddle[k] = std::complex<Real>(std::cos(t), std::sin(t));
+    }
+
+    int nbits = 0;
+    while ((1 << nbits) < m_m) ++nbits;
+    m_bitrev.resize(m_m);
+    for (int i = 0; i < m_m; ++i) {
+        int r = 0;
+        for (int b = 0; b < nbits; ++b) {
+            if (i & (1 << b)) r |= 1 << (nbits-1-b);
+        }
+        m_bitrev[i] = r;
+    }
+
+    if (!is_pow2)
+    {
+        m_chirp.resize(n);
+        for (int k = 0; k < n; ++k) {
+            // k^2 mod 2n keeps the argument small.
+            const Long k2 = (static_cast<Long>(k)*k) % (2*static_cast<Long>(n));
+            const double t = -0.5*twopi*k2/n;
+            m_chirp[k] = std::complex<Real>(std::cos(t), std::sin(t));
+        }
+        m_chirp_hat.assign(m_m, std::complex<Real>(0.,0.));
+        m_chirp_hat[0] = std::conj(m_chirp[0]);
+        for (int k = 1; k < n; ++k) {
+            m_chirp_hat[k] = m_chirp_hat[m_m-k] = std::conj(m_chirp[k]);
+        }
+        pow2(m_chirp_hat.data(), true);
+    }
+}
+
+FFTPoisson::LineFFT::~LineFFT () {}
+
+void
+FFTPoisson::LineFFT::pow2 (std::complex<Real>* x, bool forward) const
+{
+    const int m = m_m;
+    for (int i = 0; i < m; ++i) {
+        const int j = m_bitrev[i];
+        if (i < j) std::swap(x[i], x[j]);
+    }
+    for (int len = 2; len <= m; len *= 2)
+    {
+        const int half = len/2;
+        const int step = m/len;
+        for (int i = 0; i < m; i += len) {
+            for (int k = 0; k < half; ++k) {
+                const std::complex<Real> w = forward ? m_twiddle[k*step]
+                                                     : std::conj(m_twiddle[k*step]);
+                const std::complex<Real> u = x[i+k];
+                const std::complex<Real> v = x[i+k+half]*w;
+                x[i+k]      = u+v;
+                x[i+k+half] = u-v;
+            }
+        }
+    }
+}
+
+void
+FFTPoisson::LineFFT::operator() (std::complex<Real>* x, bool forward,
+                                 Vector<std::complex<Real> >& work) const
+{
+    if (m_m == m_n) {
+        pow2(x, forward);
+        return;
+    }
+
+    // Bluestein's algorithm.  The backward transform is the conjugate of the
+    // forward transform of the conjugate.
+    const int n = m_n;
+    work.resize(m_m);
+    for (int k = 0; k < n; ++k) {
+        work[k] = (forward ? x[k] : std::conj(x[k])) * m_chirp[k];
+    }
+    std::fill(work.begin()+n, work.end(), std::complex<Real>(0.,0.));
+    pow2(work.data(), true);
+    for (int k = 0; k < m_m; ++k) {
+        work[k] *= m_chirp_hat[k];
+    }
+    pow2(work.data(), false);
+    const Real fac = Real(1.0)/m_m;
+    for (int k = 0; k < n; ++k) {
+        const std::complex<Real> y = work[k] * m_chirp[k] * fac;
+        x[k] = forward ? y : std::conj(y);
+    }
+}
+
+#endif
+
+namespace {
+
+    //! Slabs of domain along direction dir, one per process as far as there are
+    //! enough cells.
+    BoxArray makeSlabs (const Box& domain, int dir, DistributionMapping& dm)
+    {
+        const int nprocs = ParallelDescriptor::NProcs();
+        const int len = domain.length(dir);
+        const int nslabs = std::min(nprocs, len);
+        BoxList bl;
+        for (int i = 0; i < nslabs; ++i) {
+            Box b = domain;
+            b.setSmall(dir, domain.smallEnd(dir) + (static_cast<Long>(len)* i   )/nslabs);
+            b.setBig  (dir, domain.smallEnd(dir) + (static_cast<Long>(len)*(i+1))/nslabs - 1);
+            bl.push_back(b);
+        }
+        Vector<int> pmap(nslabs);
+        for (int i = 0; i < nslabs; ++i) {
+            pmap[i] = i;
+        }
+        dm.define(std::move(pmap));
+        return BoxArray(std::move(bl));
+    }
+
+#if (AMREX_SPACEDIM == 2)
+    //! Integral of log(sqrt(x^2+y^2)) over [0,a]x[0,b].
+    Real intLogR (Real a, Real b)
+    {
+        return Real(0.5)*(a*b*(std::log(a*a+b*b)-Real(3.0))
+                          + a*a*std::atan(b/a) + b*b*std::atan(a/b));
+    }
+#elif (AMREX_SPACEDIM == 3)
+    //! Antiderivative of 1/r used by intInvR, with the limits of the terms
+    //! vanishing at zero.
+    Real antiInvR (Real x, Real y, Real z)
+    {
+        const Real r = std::sqrt(x*x+y*y+z*z);
+        Real t = 0.0;
+        if (x > 0.0 && y > 0.0) t += x*y*std::log(z+r);
+        if (y > 0.0 && z > 0.0) t += y*z*std::log(x+r);
+        if (z > 0.0 && x > 0.0) t += z*x*std::log(y+r);
+        if (x > 0.0) t -= Real(0.5)*x*x*std::atan(y*z/(x*r));
+        if (y > 0.0) t -= Real(0.5)*y*y*std::atan(z*x/(y*r));
+        if (z > 0.0) t -= Real(0.5)*z*z*std::atan(x*y/(z*r));
+        return t;
+    }
+
+    //! Integral of 1/r over [0,a]x[0,b]x[0,c].
+    Real intInvR (Real a, Real b, Real c)
+    {
+        return antiInvR(a,b,c) - antiInvR(0.,b,c) - antiInvR(a,0.,c) - antiInvR(a,b,0.);
+    }
+#endif
+}
+
+FFTPoisson::FFTPoisson (const Geometry& geom, BC bc)
+    : m_geom(geom), m_bc(bc)
+{
+    BL_PROFILE("FFTPoisson::FFTPoisson()");
+
+    const Box& domain = m_geom.Domain();
+    AMREX_ALWAYS_ASSERT(domain.cellCentered());
+
+    if (m_bc == BC::periodic) {
+        m_fft_domain = domain;
+        makeLayouts();
+        makeKernel();
+    } else {
+        makeOpenDomain(IntVect::TheUnitVector());
+    }
+}
+
+void
+FFTPoisson::makeOpenDomain (const IntVect& ngrow)
+{
+    // The solution at distance d from the source is correct as long as
+    // 2*d <= length, because the Green's function is even.  With ng ghost
+    // cells, d is at most n+ng-1.
+    const Box& domain = m_geom.Domain();
+    m_open_ngrow = ngrow;
+    IntVect len;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_open_ngrow[idim] = std::max(m_open_ngrow[idim], 1);
+        len[idim] = 2*(domain.length(idim) + m_open_ngrow[idim] - 1);
+    }
+    m_fft_domain = Box(domain.smallEnd(), domain.smallEnd() + len - 1);
+
+    m_line_fft.clear();
+    makeLayouts();
+    makeKernel();
+}
+
+FFTPoisson::~FFTPoisson () {}
+
+void
+FFTPoisson::makeLayouts ()
+{
+    if (AMREX_SPACEDIM == 1) {
+        // Both layouts are a single box on process 0.
+        m_ba_a = BoxArray(m_fft_domain);
+        m_dm_a.define(Vector<int>{0});
+        m_ba_b = m_ba_a;
+        m_dm_b = m_dm_a;
+    } else {
+        m_ba_a = makeSlabs(m_fft_domain, AMREX_SPACEDIM-1, m_dm_a);
+        m_ba_b = makeSlabs(m_fft_domain, 0, m_dm_b);
+    }
+}
+
+FFTPoisson::LineFFT&
+FFTPoisson::getLineFFT (int n)
+{
+    auto& p = m_line_fft[n];
+    if (!p) p.reset(new LineFFT(n));
+    return *p;
+}
+
+void
+FFTPoisson::transform (MultiFab& mf, int idim, Dir dir)
+{
+    const int n = m_fft_domain.length(idim);
+    if (n == 1) return;
+
+    const LineFFT& fft = getLineFFT(n);
+    const bool forward = dir == Dir::forward;
+
+    // mf may have been written by device kernels.
+    Gpu::synchronize();
+
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        AMREX_ASSERT(bx.length(idim) == n);
+        Array4<Real> const& a = mf.array(mfi);
+        const int lo = bx.smallEnd(idim);
+
+        Box lines = bx;
+        lines.setBig(idim, lo);
+        const Long nlines = lines.numPts();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            Vector<std::complex<Real> > line(n), work;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for (Long iline = 0; iline < nlines; ++iline)
+            {
+                IntVect iv = lines.atOffset(iline);
+                for (int m = 0; m < n; ++m) {
+                    iv[idim] = lo+m;
+                    line[m] = std::complex<Real>(a(iv,0), a(iv,1));
+                }
+                fft(line.data(), forward, work);
+                for (int m = 0; m < n; ++m) {
+                    iv[idim] = lo+m;
+                    a(iv,0) = line[m].real();
+                    a(iv,1) = line[m].imag();
+                }
+            }
+        }
+    }
+}
+
+void
+FFTPoisson::forward (MultiFab& a, MultiFab& b)
+{
+    for (int idim = 0; idim < AMREX_SPACEDIM-1; ++idim) {
+        transform(a, idim, Dir::forward);
+    }
+    b.ParallelCopy(a);
+    transform(b, AMREX_SPACEDIM-1, Dir::forward);
+}
+
+void
+FFTPoisson::backward (MultiFab& b, MultiFab& a)
+{
+    transform(b, AMREX_SPACEDIM-1, Dir::backward);
+    a.ParallelCopy(b);
+    for (int idim = 0; idim < AMREX_SPACEDIM-1; ++idim) {
+        transform(a, idim, Dir::backward);
+    }
+}
+
+void
+FFTPoisson::makeKernel ()
+{
+    BL_PROFILE("FFTPoisson::makeKernel()");
+
+    const Real* dx = m_geom.CellSize();
+    const IntVect flo = m_fft_domain.smallEnd();
+    const IntVect len = m_fft_domain.length();
+
+    m_kernel.define(m_ba_b, m_dm_b, 1, 0, MFInfo().SetArena(The_Pinned_Arena()));
+
+    if (m_bc == BC::periodic)
+    {
+        // Inverse of the eigenvalues of the discrete Laplacian.
+        const double twopi = 2.0*3.14159265358979323846;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(m_kernel,true); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real> const& k = m_kernel.array(mfi);
+            for (BoxIterator bit(bx); bit.ok(); ++bit)
+            {
+                const IntVect& iv = bit();
+                Real lambda = 0.0;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    const double t = twopi*(iv[idim]-flo[idim])/len[idim];
+                    lambda += static_cast<Real>(2.0*std::cos(t)-2.0)/(dx[idim]*dx[idim]);
+                }
+                k(iv) = (iv == flo) ? Real(0.0) : Real(1.0)/lambda;
+            }
+        }
+    }
+    else
+    {
+        // Transform of the free-space Green's function sampled at the cell
+        // centers of the doubled domain, with the average over the cell at
+        // the origin.
+        MultiFab g(m_ba_a, m_dm_a, 2, 0, MFInfo().SetArena(The_Pinned_Arena()));
+        g.setVal(0.0);
+        Gpu::synchronize();
+
+        Real vol = 1.0;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            vol *= dx[idim];
+        }
+        const Real pi = 3.14159265358979323846;
+#if (AMREX_SPACEDIM == 1)
+        const Real g0 = dx[0]/8.;
+#elif (AMREX_SPACEDIM == 2)
+        const Real g0 = intLogR(0.5*dx[0],0.5*dx[1]) / (0.5*pi*vol);
+#else
+        const Real g0 = -intInvR(0.5*dx[0],0.5*dx[1],0.5*dx[2]) / (0.5*pi*vol);
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(g,true); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real> const& ga = g.array(mfi);
+            for (BoxIterator bit(bx); bit.ok(); ++bit)
+            {
+                const IntVect& iv = bit();
+                Real r2 = 0.0;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    int m = iv[idim]-flo[idim];
+                    m = std::min(m, len[idim]-m);
+                    r2 += (m*dx[idim])*(m*dx[idim]);
+                }
+                if (iv == flo) {
+                    ga(iv,0) = g0;
+                } else {
+#if (AMREX_SPACEDIM == 1)
+                    ga(iv,0) = Real(0.5)*std::sqrt(r2);
+#elif (AMREX_SPACEDIM == 2)
+                    ga(iv,0) = Real(0.25)/pi*std::log(r2);
+#else
+                    ga(iv,0) = Real(-0.25)/pi/std::sqrt(r2);
+#endif
+                }
+            }
+        }
+
+        MultiFab gb(m_ba_b, m_dm_b, 2, 0, MFInfo().SetArena(The_Pinned_Arena()));
+        forward(g, gb);
+
+        // The Green's function is even, so its transform is real.
+        MultiFab::Copy(m_kernel, gb, 0, 0, 1, 0);
+        m_kernel.mult(vol);
+    }
+}
+
+void
+FFTPoisson::solve (MultiFab& soln, const MultiFab& rhs, int scomp, int rcomp)
+{
+    BL_PROFILE("FFTPoisson::solve()");
+
+    AMREX_ASSERT(soln.ixType().cellCentered() && rhs.ixType().cellCentered());
+
+    const Real strt_time = amrex::second();
+
+    if (m_bc == BC::open && !(soln.nGrowVect() <= m_open_ngrow)) {
+        makeOpenDomain(amrex::max(soln.nGrowVect(), m_open_ngrow));
+    }
+
+    // The transforms run on the host, so the work arrays are in pinned
+    // memory, which the ParallelCopy from and to soln and rhs can reach.
+    MultiFab a(m_ba_a, m_dm_a, 2, 0, MFInfo().SetArena(The_Pinned_Arena()));
+    a.setVal(0.0);
+    a.ParallelCopy(rhs, rcomp, 0, 1);
+
+    MultiFab b(m_ba_b, m_dm_b, 2, 0, MFInfo().SetArena(The_Pinned_Arena()));
+    forward(a, b);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(b,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        Array4<Real> const& ba = b.array(mfi);
+        Array4<Real const> const& k = m_kernel.const_array(mfi);
+        amrex::LoopOnCpu(bx, 2, [=] (int i, int j, int kk, int n) noexcept
+        {
+            ba(i,j,kk,n) *= k(i,j,kk);
+        });
+    }
+
+    backward(b, a);
+
+    a.mult(Real(1.0)/m_fft_domain.d_numPts(), 0, 1);
+
+    soln.ParallelCopy(a, 0, scomp, 1, IntVect::TheZeroVector(), soln.nGrowVect(),
+                      Periodicity(m_fft_domain.length()));
+
+    if (m_verbose > 0) {
+        Real run_time = amrex::second() - strt_time;
+        ParallelDescriptor::ReduceRealMax(run_time);
+        amrex::Print() << "FFTPoisson: solve time " << run_time << "\n";
+    }
+}
+
+}
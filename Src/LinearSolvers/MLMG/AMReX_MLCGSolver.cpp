@@ -11,6 +11,7 @@
 #include <AMReX_VisMF.H>
 #include <AMReX_ParallelReduce.H>
 #include <AMReX_MLMG.H>
+#include <AMReX_MultiFabExpr.H>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -18,38 +19,6 @@
 
 namespace amrex {
 
-namespace {
-
-static
-void
-sxay (MultiFab&       ss,
-      const MultiFab& xx,
-      Real            a,
-      const MultiFab& yy,
-      int             yycomp,
-      int             nghost)
-{
-    BL_PROFILE("CGSolver::sxay()");
-
-    const int ncomp  = ss.nComp();
-    const int sscomp = 0;
-    const int xxcomp = 0;
-    MultiFab::LinComb(ss, 1.0, xx, xxcomp, a, yy, yycomp, sscomp, ncomp, nghost);
-}
-
-inline
-void
-sxay (MultiFab&       ss,
-      const MultiFab& xx,
-      Real            a,
-      const MultiFab& yy,
-      const int       nghost)
-{
-    sxay(ss,xx,a,yy,0,nghost);
-}
-
-}
-
 MLCGSolver::MLCGSolver (MLMG* a_mlmg, MLLinOp& _lp, Type _typ)
     : mlmg(a_mlmg),
       Lp(_lp),
@@ -111,14 +80,24 @@ MLCGSolver::solve_bicgstab (MultiFab&       sol,
  
     // Then normalize
     Lp.normalize(amrlev, mglev, r);
- 
-    MultiFab::Copy(sorig,sol,0,0,ncomp,nghost);
-    MultiFab::Copy(rh,   r,  0,0,ncomp,nghost);
+
+    // The vector updates, the norms and the dot products are fused, so that
+    // an iteration only makes five passes over memory besides Lp.apply.
+    const MFExpr::Weight w(Lp.dotMask(amrlev, mglev));
+    const auto info = MFExpr::Info().SetNComp(ncomp).SetNGrow(nghost)
+                                    .SetComm(Lp.BottomCommunicator());
+
+    auto res = MFExpr::Eval(info,
+                            MFExpr::Assign(sorig, sol),
+                            MFExpr::Assign(rh, r),
+                            MFExpr::Max(MFExpr::abs(r)),
+                            MFExpr::Sum(w*r*r));
 
     sol.setVal(0);
 
-    Real rnorm = norm_inf(r);
+    Real rnorm = res[2];
     const Real rnorm0   = rnorm;
+    Real rho = res[3];
 
     if ( verbose > 0 )
     {
@@ -141,26 +120,23 @@ MLCGSolver::solve_bicgstab (MultiFab&       sol,
 
     for (; iter <= maxiter; ++iter)
     {
-        const Real rho = dotxy(rh,r);
         if ( rho == 0 ) 
 	{
             ret = 1; break;
 	}
         if ( iter == 1 )
         {
-            MultiFab::Copy(p,r,0,0,ncomp,nghost);
+            MFExpr::Eval(info, MFExpr::Assign(p, r), MFExpr::Assign(ph, r));
         }
         else
         {
             const Real beta = (rho/rho_1)*(alpha/omega);
-            sxay(p, p, -omega, v, nghost);
-            sxay(p, r,   beta, p, nghost);
+            MFExpr::Eval(info, MFExpr::Assign(p, r + beta*(p - omega*v)), MFExpr::Assign(ph, p));
         }
-        MultiFab::Copy(ph,p,0,0,ncomp,nghost);
         Lp.apply(amrlev, mglev, v, ph, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
         Lp.normalize(amrlev, mglev, v);
 
-        if ( Real rhTv = dotxy(rh,v) )
+        if ( Real rhTv = MFExpr::Eval(info, MFExpr::Sum(w*rh*v))[0] )
 	{
             alpha = rho/rhTv;
 	}
@@ -168,13 +144,16 @@ MLCGSolver::solve_bicgstab (MultiFab&       sol,
 	{
             ret = 2; break;
 	}
-        sxay(sol, sol,  alpha, ph, nghost);
-        sxay(s,     r, -alpha,  v, nghost);
+        res = MFExpr::Eval(info,
+                           MFExpr::Assign(sol, sol + alpha*ph),
+                           MFExpr::Assign(s, r - alpha*v),
+                           MFExpr::Assign(sh, s),
+                           MFExpr::Max(MFExpr::abs(s)));
 
         //Subtract mean from s 
 //        if (Lp.isBottomSingular()) mlmg->makeSolvable(amrlev, mglev, s);
  
-        rnorm = norm_inf(s);
+        rnorm = res[3];
 
         if ( verbose > 2 && ParallelDescriptor::IOProcessor() )
         {
@@ -186,19 +165,10 @@ MLCGSolver::solve_bicgstab (MultiFab&       sol,
 
         if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
 
-        MultiFab::Copy(sh,s,0,0,ncomp,nghost);
         Lp.apply(amrlev, mglev, t, sh, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
         Lp.normalize(amrlev, mglev, t);
-        //
-        // This is a little funky.  I want to elide one of the reductions
-        // in the following two dotxy()s.  We do that by calculating the "local"
-        // values and then reducing the two local values at the same time.
-        //
-        Real tvals[2] = { dotxy(t,t,true), dotxy(t,s,true) };
 
-        BL_PROFILE_VAR("MLCGSolver::ParallelAllReduce", blp_par);
-        ParallelAllReduce::Sum(tvals,2,Lp.BottomCommunicator());
-        BL_PROFILE_VAR_STOP(blp_par);
+        auto tvals = MFExpr::Eval(info, MFExpr::Sum(w*t*t), MFExpr::Sum(w*t*s));
 
         if ( tvals[0] )
 	{
@@ -208,12 +178,20 @@ MLCGSolver::solve_bicgstab (MultiFab&       sol,
 	{
             ret = 3; break;
 	}
-        sxay(sol, sol,  omega, sh, nghost);
-        sxay(r,     s, -omega,  t, nghost);
+
+        rho_1 = rho;
+
+        // The dot product of the next iteration is done here too.
+        res = MFExpr::Eval(info,
+                           MFExpr::Assign(sol, sol + omega*sh),
+                           MFExpr::Assign(r, s - omega*t),
+                           MFExpr::Max(MFExpr::abs(r)),
+                           MFExpr::Sum(w*rh*r));
 
 //        if (Lp.isBottomSingular()) mlmg->makeSolvable(amrlev, mglev, r);
 
-        rnorm = norm_inf(r);
+        rnorm = res[2];
+        rho = res[3];
 
         if ( verbose > 2 )
         {
@@ -229,7 +207,6 @@ MLCGSolver::solve_bicgstab (MultiFab&       sol,
 	{
             ret = 4; break;
 	}
-        rho_1 = rho;
     }
 
     if ( verbose > 0 )
@@ -279,7 +256,6 @@ MLCGSolver::solve_cg (MultiFab&       sol,
 
     MultiFab sorig(ba, dm, ncomp, nghost, MFInfo(), factory);
     MultiFab r    (ba, dm, ncomp, nghost, MFInfo(), factory);
-    MultiFab z    (ba, dm, ncomp, nghost, MFInfo(), factory);
     MultiFab q    (ba, dm, ncomp, nghost, MFInfo(), factory);
 
     MultiFab::Copy(sorig,sol,0,0,ncomp,nghost);
@@ -288,8 +264,17 @@ MLCGSolver::solve_cg (MultiFab&       sol,
 
     sol.setVal(0);
 
-    Real       rnorm    = norm_inf(r);
+    // The vector updates, the norm and the dot product of the next iteration
+    // are fused.
+    const MFExpr::Weight w(Lp.dotMask(amrlev, mglev));
+    const auto info = MFExpr::Info().SetNComp(ncomp).SetNGrow(nghost)
+                                    .SetComm(Lp.BottomCommunicator());
+
+    auto res = MFExpr::Eval(info, MFExpr::Max(MFExpr::abs(r)), MFExpr::Sum(w*r*r));
+
+    Real       rnorm    = res[0];
     const Real rnorm0   = rnorm;
+    Real       rho      = res[1];
 
     if ( verbose > 0 )
     {
@@ -312,27 +297,23 @@ MLCGSolver::solve_cg (MultiFab&       sol,
 
     for (; iter <= maxiter; ++iter)
     {
-        MultiFab::Copy(z,r,0,0,ncomp,nghost);
-
-        Real rho = dotxy(z,r);
-
         if ( rho == 0 )
         {
             ret = 1; break;
         }
         if (iter == 1)
         {
-            MultiFab::Copy(p,z,0,0,ncomp,nghost);
+            MFExpr::Eval(info, MFExpr::Assign(p, r));
         }
         else
         {
             Real beta = rho/rho_1;
-            sxay(p, z, beta, p, nghost);
+            MFExpr::Eval(info, MFExpr::Assign(p, r + beta*p));
         }
         Lp.apply(amrlev, mglev, q, p, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
 
         Real alpha;
-        if ( Real pw = dotxy(p,q) )
+        if ( Real pw = MFExpr::Eval(info, MFExpr::Sum(w*p*q))[0] )
 	{
             alpha = rho/pw;
 	}
@@ -348,9 +329,16 @@ MLCGSolver::solve_cg (MultiFab&       sol,
                            << " rho " << rho
                            << " alpha " << alpha << '\n';
         }
-        sxay(sol, sol, alpha, p, nghost);
-        sxay(  r,   r,-alpha, q, nghost);
-        rnorm = norm_inf(r);
+
+        rho_1 = rho;
+
+        const auto upd = MFExpr::Eval(info,
+                                      MFExpr::Assign(sol, sol + alpha*p),
+                                      MFExpr::Assign(r, r - alpha*q),
+                                      MFExpr::Max(MFExpr::abs(r)),
+                                      MFExpr::Sum(w*r*r));
+        rnorm = upd[2];
+        rho = upd[3];
 
         if ( verbose > 2 )
         {
@@ -361,8 +349,6 @@ MLCGSolver::solve_cg (MultiFab&       sol,
         }
 
         if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
-
-        rho_1 = rho;
     }
     
     if ( verbose > 0 )
@@ -0,0 +1,367 @@
+
+#include <algorithm>
+#include <iomanip>
+#include <cmath>
+
+#include <AMReX_MLKrylovSolver.H>
+#include <AMReX_MLMG.H>
+#include <AMReX_MultiFabExpr.H>
+#include <AMReX_ParallelReduce.H>
+
+namespace amrex {
+
+MLKrylovSolver::MLKrylovSolver (MLMG& a_mlmg, Type a_type)
+    : m_mlmg(a_mlmg),
+      m_linop(a_mlmg.linop),
+      m_type(a_type)
+{
+    if (m_linop.NAMRLevels() != 1 || !m_linop.isCellCentered()) {
+        amrex::Abort("MLKrylovSolver: only single-level cell-centered MLLinOps are supported."
+                     " Use MLMG for multi-level or nodal solves.");
+    }
+}
+
+MLKrylovSolver::~MLKrylovSolver () {}
+
+Real
+MLKrylovSolver::solve (MultiFab& a_sol, const MultiFab& a_rhs, Real a_tol_rel, Real a_tol_abs)
+{
+    BL_PROFILE("MLKrylovSolver::solve()");
+
+    // The bottom solver of the preconditioner is chosen like in MLMG::solve,
+    // but the settings of the MLMG and the MLLinOp are restored on exit.
+    struct BottomSolverRestorer
+    {
+        BottomSolverRestorer (MLMG& a_mlmg, MLLinOp& a_linop)
+            : mlmg(a_mlmg), linop(a_linop),
+              bottom_solver(a_mlmg.bottom_solver), maxorder(a_linop.getMaxOrder()) {}
+        ~BottomSolverRestorer () {
+            mlmg.bottom_solver = bottom_solver;
+            linop.setMaxOrder(maxorder);
+        }
+        MLMG& mlmg;
+        MLLinOp& linop;
+        BottomSolver bottom_solver;
+        int maxorder;
+    };
+    BottomSolverRestorer bottom_solver_restorer(m_mlmg, m_linop);
+
+    if (m_mlmg.bottom_solver == BottomSolver::Default) {
+        m_mlmg.bottom_solver = m_linop.getDefaultBottomSolver();
+    }
+
+    if (m_mlmg.bottom_solver == BottomSolver::hypre) {
+        int mo = m_linop.getMaxOrder();
+        m_linop.setMaxOrder(std::min(3,mo));  // maxorder = 4 not supported
+    }
+
+    const int ncomp = m_linop.getNComp();
+
+    m_res_history.clear();
+
+    m_mlmg.prepareForSolve({&a_sol}, {&a_rhs});
+
+    // The Krylov solver is for the correction, with homogeneous BC.
+    m_mlmg.computeResidual(0);
+
+    MultiFab res = makeVector(0);
+    MultiFab::Copy(res, m_mlmg.res[0][0], 0, 0, ncomp, 0);
+    if (m_linop.isSingular(0)) {
+        m_mlmg.makeSolvable(0, 0, res);
+    }
+
+    const Real rnorm0 = norm2(res);
+    const Real bnorm = norm2(m_mlmg.rhs[0]);
+    m_init_resnorm = rnorm0;
+
+    Real max_norm;
+    std::string norm_name;
+    if (m_mlmg.always_use_bnorm or bnorm >= rnorm0) {
+        norm_name = "bnorm";
+        max_norm = bnorm;
+    } else {
+        norm_name = "resid0";
+        max_norm = rnorm0;
+    }
+    const Real target = std::max(a_tol_abs, std::max(a_tol_rel,1.e-16_rt)*max_norm);
+
+    if (m_verbose >= 1) {
+        amrex::Print() << "MLKrylovSolver: Initial rhs               = " << bnorm << "\n"
+                       << "MLKrylovSolver: Initial residual (resid0) = " << rnorm0 << "\n";
+    }
+
+    MultiFab cor = makeVector(1);
+    cor.setVal(0.0);
+
+    bool converged = (rnorm0 <= target);
+    if (converged) {
+        if (m_verbose >= 1) {
+            amrex::Print() << "MLKrylovSolver: No iterations needed\n";
+        }
+    } else if (m_type == Type::fgmres) {
+        converged = solve_fgmres(cor, res, target);
+    } else {
+        converged = solve_pcg(cor, res, target);
+    }
+
+    MultiFab& sol = *m_mlmg.sol[0];
+    MultiFab::Add(sol, cor, 0, 0, ncomp, 0);
+
+    // The true residual
+    m_mlmg.computeResidual(0);
+    m_final_resnorm = norm2(m_mlmg.res[0][0]);
+
+    if (converged) {
+        if (m_verbose >= 1) {
+            amrex::Print() << "MLKrylovSolver: Final Iter. " << getNumIters()
+                           << " resid, resid/" << norm_name << " = "
+                           << m_final_resnorm << ", " << m_final_resnorm/max_norm << "\n";
+        }
+    } else {
+        if (m_verbose > 0) {
+            amrex::Print() << "MLKrylovSolver: Failed to converge after " << getNumIters()
+                           << " iterations. resid, resid/" << norm_name << " = "
+                           << m_final_resnorm << ", " << m_final_resnorm/max_norm << "\n";
+        }
+        amrex::Abort("MLKrylovSolver failed");
+    }
+
+    if (&a_sol != &sol) {
+        MultiFab::Copy(a_sol, sol, 0, 0, ncomp, 0);
+    }
+
+    ++m_mlmg.solve_called;
+
+    return m_final_resnorm;
+}
+
+bool
+MLKrylovSolver::solve_fgmres (MultiFab& cor, const MultiFab& res, Real target)
+{
+    BL_PROFILE("MLKrylovSolver::fgmres()");
+
+    const int ncomp = m_linop.getNComp();
+    const int m = std::max(m_restart, 1);
+
+    // Krylov basis, and the preconditioned basis that spans the correction
+    Vector<MultiFab> V(m+1);
+    Vector<MultiFab> Z(m);
+    V[0] = makeVector(0);
+
+    // Hessenberg matrix stored by column, Givens rotations and rhs of the
+    // least squares problem
+    Vector<Real> H((m+1)*m);
+    auto h = [&] (int i, int j) -> Real& { return H[j*(m+1)+i]; };
+    Vector<Real> cs(m), sn(m), g(m+1), y(m), dots(m+1);
+
+    MultiFab r = makeVector(0);
+    MultiFab w = makeVector(0);
+    MultiFab::Copy(r, res, 0, 0, ncomp, 0);
+    Real beta = norm2(r);
+
+    bool converged = false;
+    int iter = 0;
+    while (!converged && iter < m_maxiter)
+    {
+        MultiFab::Copy(V[0], r, 0, 0, ncomp, 0);
+        V[0].mult(1.0/beta);
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+        std::fill(H.begin(), H.end(), 0.0);
+
+        int k = 0;
+        for (int j = 0; j < m && iter < m_maxiter; ++j)
+        {
+            if (Z[j].empty()) Z[j] = makeVector(1);
+            precond(Z[j], V[j]);
+            apply(w, Z[j]);
+
+            // Classical Gram-Schmidt done twice, with a single reduction
+            // for all the dot products of each pass.
+            for (int pass = 0; pass < 2; ++pass) {
+                for (int i = 0; i <= j; ++i) {
+                    dots[i] = m_linop.xdoty(0, 0, w, V[i], true);
+                }
+                ParallelAllReduce::Sum(dots.data(), j+1, ParallelContext::CommunicatorSub());
+                for (int i = 0; i <= j; ++i) {
+                    h(i,j) += dots[i];
+                    MultiFab::Saxpy(w, -dots[i], V[i], 0, 0, ncomp, 0);
+                }
+            }
+            const Real hnext = norm2(w);
+            h(j+1,j) = hnext;
+
+            for (int i = 0; i < j; ++i) {
+                const Real t = cs[i]*h(i,j) + sn[i]*h(i+1,j);
+                h(i+1,j) = -sn[i]*h(i,j) + cs[i]*h(i+1,j);
+                h(i,j) = t;
+            }
+            const Real d = std::sqrt(h(j,j)*h(j,j) + h(j+1,j)*h(j+1,j));
+            cs[j] = (d > 0.0) ? h(j,j)/d : 1.0;
+            sn[j] = (d > 0.0) ? h(j+1,j)/d : 0.0;
+            h(j,j) = d;
+            h(j+1,j) = 0.0;
+            g[j+1] = -sn[j]*g[j];
+            g[j] *= cs[j];
+
+            k = j+1;
+            ++iter;
+
+            const Real rnorm = std::abs(g[j+1]);
+            m_res_history.push_back(rnorm);
+            if (m_verbose >= 2) {
+                amrex::Print() << "MLKrylovSolver: FGMRES Iteration " << std::setw(4) << iter
+                               << " resid " << rnorm << "\n";
+            }
+
+            if (rnorm <= target) {
+                converged = true;
+                break;
+            }
+
+            if (hnext == 0.0) break;
+            if (V[j+1].empty()) V[j+1] = makeVector(0);
+            MultiFab::Copy(V[j+1], w, 0, 0, ncomp, 0);
+            V[j+1].mult(1.0/hnext);
+        }
+
+        // Solve the upper triangular system and update the correction.
+        for (int i = k-1; i >= 0; --i) {
+            Real s = g[i];
+            for (int l = i+1; l < k; ++l) {
+                s -= h(i,l)*y[l];
+            }
+            y[i] = (h(i,i) != 0.0) ? s/h(i,i) : 0.0;
+        }
+        for (int i = 0; i < k; ++i) {
+            MultiFab::Saxpy(cor, y[i], Z[i], 0, 0, ncomp, 0);
+        }
+
+        if (converged || iter >= m_maxiter) break;
+
+        // Restart with the true residual.
+        m_linop.correctionResidual(0, 0, r, cor, res, MLLinOp::BCMode::Homogeneous);
+        if (m_linop.isSingular(0)) {
+            m_mlmg.makeSolvable(0, 0, r);
+        }
+        beta = norm2(r);
+        converged = (beta <= target);
+        if (m_verbose >= 2) {
+            amrex::Print() << "MLKrylovSolver: FGMRES Restart after " << iter
+                           << " iterations, resid " << beta << "\n";
+        }
+    }
+
+    return converged;
+}
+
+bool
+MLKrylovSolver::solve_pcg (MultiFab& cor, const MultiFab& res, Real target)
+{
+    BL_PROFILE("MLKrylovSolver::pcg()");
+
+    const int ncomp = m_linop.getNComp();
+    const auto info = MFExpr::Info().SetNComp(ncomp);
+
+    MultiFab r    = makeVector(0);
+    MultiFab rold = makeVector(0);
+    MultiFab q    = makeVector(0);
+    MultiFab z    = makeVector(1);
+    MultiFab p    = makeVector(1);
+
+    MultiFab::Copy(r, res, 0, 0, ncomp, 0);
+    precond(z, r);
+    MultiFab::Copy(p, z, 0, 0, ncomp, 0);
+    Real rho = MFExpr::Eval(info, MFExpr::Sum(z*r))[0];
+
+    bool converged = false;
+    for (int iter = 1; iter <= m_maxiter; ++iter)
+    {
+        apply(q, p);
+
+        const Real pq = MFExpr::Eval(info, MFExpr::Sum(p*q))[0];
+        if (pq == 0.0 || rho == 0.0) break;
+        const Real alpha = rho/pq;
+
+        auto rr = MFExpr::Eval(info,
+                               MFExpr::Assign(cor, cor + alpha*p),
+                               MFExpr::Assign(rold, r),
+                               MFExpr::Assign(r, r - alpha*q),
+                               MFExpr::Sum(r*r));
+        const Real rnorm = std::sqrt(rr[3]);
+        m_res_history.push_back(rnorm);
+        if (m_verbose >= 2) {
+            amrex::Print() << "MLKrylovSolver: PCG Iteration " << std::setw(4) << iter
+                           << " resid " << rnorm << "\n";
+        }
+
+        if (rnorm <= target) {
+            converged = true;
+            break;
+        }
+
+        precond(z, r);
+
+        // Polak-Ribiere form of beta, which tolerates a varying preconditioner
+        auto zr = MFExpr::Eval(info, MFExpr::Sum(z*r), MFExpr::Sum(z*rold));
+        const Real beta = (zr[0] - zr[1]) / rho;
+        rho = zr[0];
+
+        MFExpr::Eval(info, MFExpr::Assign(p, z + beta*p));
+    }
+
+    return converged;
+}
+
+void
+MLKrylovSolver::apply (MultiFab& out, MultiFab& in)
+{
+    m_linop.apply(0, 0, out, in, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+}
+
+void
+MLKrylovSolver::precond (MultiFab& z, const MultiFab& r)
+{
+    BL_PROFILE("MLKrylovSolver::precond()");
+
+    const int ncomp = m_linop.getNComp();
+
+    if (m_precond_iter <= 0) {
+        MultiFab::Copy(z, r, 0, 0, ncomp, 0);
+        return;
+    }
+
+    MultiFab& mgres = m_mlmg.res[0][0];
+    const MultiFab& mgcor = *m_mlmg.cor[0][0];
+
+    z.setVal(0.0);
+    for (int it = 0; it < m_precond_iter; ++it)
+    {
+        if (it == 0) {
+            MultiFab::Copy(mgres, r, 0, 0, ncomp, 0);
+        } else {
+            m_linop.correctionResidual(0, 0, mgres, z, r, MLLinOp::BCMode::Homogeneous);
+        }
+        if (m_linop.isSingular(0)) {
+            m_mlmg.makeSolvable(0, 0, mgres);
+        }
+        m_mlmg.mgVcycle(0, 0);
+        MultiFab::Add(z, mgcor, 0, 0, ncomp, 0);
+    }
+}
+
+Real
+MLKrylovSolver::norm2 (const MultiFab& mf)
+{
+    return std::sqrt(m_linop.xdoty(0, 0, mf, mf, false));
+}
+
+MultiFab
+MLKrylovSolver::makeVector (int ngrow) const
+{
+    const MultiFab& res = m_mlmg.res[0][0];
+    return MultiFab(res.boxArray(), res.DistributionMap(), m_linop.getNComp(), ngrow,
+                    MFInfo(), *m_linop.Factory(0));
+}
+
+}
@@ -82,35 +82,84 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
 
     int ncomp = linop.getNComp();
 
+    // Without per component convergence, the components are tracked as one.
+    const int ntrack = m_comp_convergence ? ncomp : 1;
+    auto track = [=] (Vector<Real> const& v) -> Vector<Real>
+    {
+        if (ntrack == ncomp) return v;
+        return Vector<Real>{*std::max_element(v.begin(), v.end())};
+    };
+
     bool local = true;
-    Real resnorm0 = MLResNormInf(finest_amr_lev, local); 
-    Real rhsnorm0 = MLRhsNormInf(local); 
+    Vector<Real> resnorm0 = track(MLResNormInfComp(finest_amr_lev, local));
+    Vector<Real> rhsnorm0 = track(MLRhsNormInfComp(local));
     if (!is_nsolve) {
-        ParallelAllReduce::Max<Real>({resnorm0, rhsnorm0}, ParallelContext::CommunicatorSub());
-
-        if (verbose >= 1)
-        {
-            amrex::Print() << "MLMG: Initial rhs               = " << rhsnorm0 << "\n"
-                           << "MLMG: Initial residual (resid0) = " << resnorm0 << "\n";
-        }
+        Vector<Real> tmp(resnorm0);
+        tmp.insert(tmp.end(), rhsnorm0.begin(), rhsnorm0.end());
+        ParallelAllReduce::Max<Real>(tmp.data(), tmp.size(), ParallelContext::CommunicatorSub());
+        std::copy(tmp.begin(), tmp.begin()+ntrack, resnorm0.begin());
+        std::copy(tmp.begin()+ntrack, tmp.end(), rhsnorm0.begin());
     }
 
-    m_init_resnorm0 = resnorm0;
-    m_rhsnorm0 = rhsnorm0;
+    m_init_resnorm0 = *std::max_element(resnorm0.begin(), resnorm0.end());
+    m_rhsnorm0 = *std::max_element(rhsnorm0.begin(), rhsnorm0.end());
 
-    Real max_norm;
+    if (!is_nsolve && verbose >= 1)
+    {
+        amrex::Print() << "MLMG: Initial rhs               = " << m_rhsnorm0 << "\n"
+                       << "MLMG: Initial residual (resid0) = " << m_init_resnorm0 << "\n";
+    }
+
+    Vector<Real> max_norm(ntrack);
+    Vector<Real> res_target(ntrack);
     std::string norm_name;
-    if (always_use_bnorm or rhsnorm0 >= resnorm0) {
-        norm_name = "bnorm";
-        max_norm = rhsnorm0;
-    } else {
-        norm_name = "resid0";
-        max_norm = resnorm0;
+    for (int n = 0; n < ntrack; ++n) {
+        if (always_use_bnorm or rhsnorm0[n] >= resnorm0[n]) {
+            norm_name = "bnorm";
+            max_norm[n] = rhsnorm0[n];
+        } else {
+            norm_name = "resid0";
+            max_norm[n] = resnorm0[n];
+        }
+        res_target[n] = std::max(a_tol_abs, std::max(a_tol_rel,1.e-16_rt)*max_norm[n]);
     }
-    const Real res_target = std::max(a_tol_abs, std::max(a_tol_rel,1.e-16_rt)*max_norm);
+    if (ntrack > 1) norm_name = "norm";
+
+    // The scaled residual, which is used for printing
+    auto scaled = [&] (Vector<Real> const& r) -> Real
+    {
+        Real x = 0.0;
+        for (int n = 0; n < ntrack; ++n) {
+            if (max_norm[n] > 0.0) {
+                x = std::max(x, r[n]/max_norm[n]);
+            } else if (r[n] > 0.0) {
+                x = std::numeric_limits<Real>::max();
+            }
+        }
+        return x;
+    };
+
+    Vector<Real> comp_norminf = resnorm0;
+    m_final_resnorm_comp = comp_norminf;
+    m_niters_comp.assign(ntrack, 0);
+
+    auto update_converged = [&] (Vector<Real> const& r, int iter) -> bool
+    {
+        bool all = true;
+        for (int n = 0; n < ntrack; ++n) {
+            if (r[n] <= res_target[n]) {
+                if (m_niters_comp[n] < 0) m_niters_comp[n] = iter;
+            } else {
+                m_niters_comp[n] = -1;
+                all = false;
+            }
+        }
+        return all;
+    };
+
+    composite_norminf = m_init_resnorm0;
 
-    if (!is_nsolve && resnorm0 <= res_target) {
-        composite_norminf = resnorm0;
+    if (!is_nsolve && update_converged(resnorm0, 0)) {
         if (verbose >= 1) {
             amrex::Print() << "MLMG: No iterations needed\n";
         }
@@ -130,48 +179,57 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
 
             if (is_nsolve) continue;
 
-            Real fine_norminf = ResNormInf(finest_amr_lev);
-            m_iter_fine_resnorm0.push_back(fine_norminf);
-            composite_norminf = fine_norminf;
+            Vector<Real> fine_norminf = track(ResNormInfComp(finest_amr_lev));
+            m_iter_fine_resnorm0.push_back(*std::max_element(fine_norminf.begin(),
+                                                             fine_norminf.end()));
+            comp_norminf = fine_norminf;
             if (verbose >= 2) {
                 amrex::Print() << "MLMG: Iteration " << std::setw(3) << iter+1 << " Fine resid/"
-                               << norm_name << " = " << fine_norminf/max_norm << "\n";
+                               << norm_name << " = " << scaled(fine_norminf) << "\n";
+            }
+            bool fine_converged = true;
+            for (int n = 0; n < ntrack; ++n) {
+                fine_converged = fine_converged && (fine_norminf[n] <= res_target[n]);
             }
-            bool fine_converged = (fine_norminf <= res_target);
 
-            if (namrlevs == 1 and fine_converged) {
-                converged = true;
+            if (namrlevs == 1) {
+                converged = update_converged(comp_norminf, iter+1);
             } else if (fine_converged) {
                 // finest level is converged, but we still need to test the coarse levels
                 computeMLResidual(finest_amr_lev-1);
-                Real crse_norminf = MLResNormInf(finest_amr_lev-1);
+                Vector<Real> crse_norminf = track(MLResNormInfComp(finest_amr_lev-1));
                 if (verbose >= 2) {
                     amrex::Print() << "MLMG: Iteration " << std::setw(3) << iter+1
                                    << " Crse resid/" << norm_name << " = "
-                                   << crse_norminf/max_norm << "\n";
+                                   << scaled(crse_norminf) << "\n";
+                }
+                for (int n = 0; n < ntrack; ++n) {
+                    comp_norminf[n] = std::max(fine_norminf[n], crse_norminf[n]);
                 }
-                converged = (crse_norminf <= res_target);
-                composite_norminf = std::max(fine_norminf, crse_norminf);
+                converged = update_converged(comp_norminf, iter+1);
             } else {
                 converged = false;
             }
 
+            composite_norminf = *std::max_element(comp_norminf.begin(), comp_norminf.end());
+            m_final_resnorm_comp = comp_norminf;
+
             if (converged) {
                 if (verbose >= 1) {
                     amrex::Print() << "MLMG: Final Iter. " << iter+1
                                    << " resid, resid/" << norm_name << " = "
                                    << composite_norminf << ", "
-                                   << composite_norminf/max_norm << "\n";
+                                   << scaled(comp_norminf) << "\n";
                 }
                 break;
             } else {
-              if (composite_norminf > 1.e20*max_norm) 
+              if (scaled(comp_norminf) > 1.e20)
               {
                   if (verbose > 0) {
                       amrex::Print() << "MLMG: Failing to converge after " << iter+1 << " iterations."
                                      << " resid, resid/" << norm_name << " = "
                                      << composite_norminf << ", "
-                                     << composite_norminf/max_norm << "\n";
+                                     << scaled(comp_norminf) << "\n";
                       amrex::Abort("MLMG failing so lets stop here");
                   }
               }
@@ -183,7 +241,7 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
                 amrex::Print() << "MLMG: Failed to converge after " << max_iters << " iterations."
                                << " resid, resid/" << norm_name << " = "
                                << composite_norminf << ", "
-                               << composite_norminf/max_norm << "\n";
+                               << scaled(comp_norminf) << "\n";
             }
             amrex::Abort("MLMG failed");
         }
@@ -216,6 +274,50 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
     return composite_norminf;
 }
 
+Real
+MLMG::solve (const Vector<Vector<MultiFab*> >& a_sol,
+             const Vector<Vector<MultiFab const*> >& a_rhs,
+             Real a_tol_rel, Real a_tol_abs)
+{
+    BL_PROFILE("MLMG::solve(multi-rhs)");
+
+    const int nrhs = a_sol.size();
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nrhs == static_cast<int>(a_rhs.size()) &&
+                                     nrhs == linop.getNComp(),
+                                     "MLMG::solve: number of rhs must be the number of components of MLLinOp");
+
+    Vector<MultiFab> sol_all(namrlevs);
+    Vector<MultiFab> rhs_all(namrlevs);
+    for (int alev = 0; alev < namrlevs; ++alev)
+    {
+        const MultiFab& s0 = *a_sol[0][alev];
+        const MultiFab& r0 = *a_rhs[0][alev];
+        const int ng = s0.nGrow();
+        sol_all[alev].define(s0.boxArray(), s0.DistributionMap(), nrhs, ng, MFInfo(), s0.Factory());
+        rhs_all[alev].define(r0.boxArray(), r0.DistributionMap(), nrhs, 0, MFInfo(), r0.Factory());
+        for (int n = 0; n < nrhs; ++n) {
+            AMREX_ALWAYS_ASSERT(a_sol[n][alev]->nComp() == 1 && a_rhs[n][alev]->nComp() == 1);
+            MultiFab::Copy(sol_all[alev], *a_sol[n][alev], 0, n, 1, ng);
+            MultiFab::Copy(rhs_all[alev], *a_rhs[n][alev], 0, n, 1, 0);
+        }
+    }
+
+    m_comp_convergence = true;
+    Real r = solve(amrex::GetVecOfPtrs(sol_all), amrex::GetVecOfConstPtrs(rhs_all),
+                   a_tol_rel, a_tol_abs);
+    m_comp_convergence = false;
+
+    int ng_back = final_fill_bc ? 1 : 0;
+    for (int alev = 0; alev < namrlevs; ++alev)
+    {
+        for (int n = 0; n < nrhs; ++n) {
+            MultiFab::Copy(*a_sol[n][alev], sol_all[alev], n, 0, 1, ng_back);
+        }
+    }
+
+    return r;
+}
+
 // in  : Residual (res) on the finest AMR level
 // out : sol on all AMR levels
 void MLMG::oneIter (int iter)
@@ -1007,11 +1109,42 @@ MLMG::bottomSolveWithCG (MultiFab& x, const MultiFab& b, MLCGSolver::Type type)
 // Compute single-level masked inf-norm of Residual (res).
 Real
 MLMG::ResNormInf (int alev, bool local)
+{
+    Vector<Real> const& norm = ResNormInfComp(alev, true);
+    Real r = *std::max_element(norm.begin(), norm.end());
+    if (!local) ParallelAllReduce::Max(r, ParallelContext::CommunicatorSub());
+    return r;
+}
+
+// Computes multi-level masked inf-norm of Residual (res).
+Real
+MLMG::MLResNormInf (int alevmax, bool local)
+{
+    Vector<Real> const& norm = MLResNormInfComp(alevmax, true);
+    Real r = *std::max_element(norm.begin(), norm.end());
+    if (!local) ParallelAllReduce::Max(r, ParallelContext::CommunicatorSub());
+    return r;
+}
+
+// Compute multi-level masked inf-norm of RHS (rhs).
+Real
+MLMG::MLRhsNormInf (bool local)
+{
+    Vector<Real> const& norm = MLRhsNormInfComp(true);
+    Real r = *std::max_element(norm.begin(), norm.end());
+    if (!local) ParallelAllReduce::Max(r, ParallelContext::CommunicatorSub());
+    return r;
+}
+
+// Computes the masked inf-norm of each component of Residual (res), with a
+// single reduction for all components.
+Vector<Real>
+MLMG::ResNormInfComp (int alev, bool local)
 {
     BL_PROFILE("MLMG::ResNormInf()");
     const int ncomp = linop.getNComp();
     const int mglev = 0;
-    Real norm = 0.0;
+    Vector<Real> norm(ncomp, 0.0);
     MultiFab* pmf = &(res[alev][mglev]);
 #ifdef AMREX_USE_EB
     if (linop.isCellCentered() && scratch[alev]) {
@@ -1026,39 +1159,41 @@ MLMG::ResNormInf (int alev, bool local)
 #endif
     for (int n = 0; n < ncomp; n++)
     {
-	Real newnorm = 0.0;
 	if (fine_mask[alev]) {
-            newnorm = pmf->norm0(*fine_mask[alev],n,0,true);
+            norm[n] = pmf->norm0(*fine_mask[alev],n,0,true);
 	} else {
-            newnorm = pmf->norm0(n,0,true);
+            norm[n] = pmf->norm0(n,0,true);
 	}
-        norm = std::max(norm, newnorm);
     }
-    if (!local) ParallelAllReduce::Max(norm, ParallelContext::CommunicatorSub());
+    if (!local) ParallelAllReduce::Max(norm.data(), ncomp, ParallelContext::CommunicatorSub());
     return norm;
 }
 
-// Computes multi-level masked inf-norm of Residual (res).
-Real
-MLMG::MLResNormInf (int alevmax, bool local)
+// Computes multi-level masked inf-norm of each component of Residual (res).
+Vector<Real>
+MLMG::MLResNormInfComp (int alevmax, bool local)
 {
     BL_PROFILE("MLMG::MLResNormInf()");
-    Real r = 0.0;
+    const int ncomp = linop.getNComp();
+    Vector<Real> r(ncomp, 0.0);
     for (int alev = 0; alev <= alevmax; ++alev)
     {
-        r = std::max(r, ResNormInf(alev,true));
+        Vector<Real> const& rlev = ResNormInfComp(alev,true);
+        for (int n = 0; n < ncomp; ++n) {
+            r[n] = std::max(r[n], rlev[n]);
+        }
     }
-    if (!local) ParallelAllReduce::Max(r, ParallelContext::CommunicatorSub());
+    if (!local) ParallelAllReduce::Max(r.data(), ncomp, ParallelContext::CommunicatorSub());
     return r;
 }
 
-// Compute multi-level masked inf-norm of RHS (rhs).
-Real
-MLMG::MLRhsNormInf (bool local)
+// Compute multi-level masked inf-norm of each component of RHS (rhs).
+Vector<Real>
+MLMG::MLRhsNormInfComp (bool local)
 {
     BL_PROFILE("MLMG::MLRhsNormInf()");
     const int ncomp = linop.getNComp();
-    Real r = 0.0;
+    Vector<Real> r(ncomp, 0.0);
     for (int alev = 0; alev <= finest_amr_lev; ++alev)
     {
         MultiFab* pmf = &(rhs[alev]);
@@ -1076,13 +1211,13 @@ MLMG::MLRhsNormInf (bool local)
         for (int n=0; n<ncomp; ++n)
         {
             if (alev < finest_amr_lev) {
-                r = std::max(r, pmf->norm0(*fine_mask[alev],n,0,true));
+                r[n] = std::max(r[n], pmf->norm0(*fine_mask[alev],n,0,true));
             } else {
-                r = std::max(r, pmf->norm0(n,0,true));
+                r[n] = std::max(r[n], pmf->norm0(n,0,true));
             }
         }
     }
-    if (!local) ParallelAllReduce::Max(r, ParallelContext::CommunicatorSub());
+    if (!local) ParallelAllReduce::Max(r.data(), ncomp, ParallelContext::CommunicatorSub());
     return r;
 }
 
@@ -135,6 +135,20 @@ void
 MLNodeLaplacian::setSigma (int amrlev, const MultiFab& a_sigma)
 {
     MultiFab::Copy(*m_sigma[amrlev][0][0], a_sigma, 0, 0, 1, 0);
+    m_const_sigma = 0.0;
+}
+
+void
+MLNodeLaplacian::setConstantSigma (Real a_sigma)
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(a_sigma != 0.0,
+                                     "MLNodeLaplacian::setConstantSigma: sigma must be nonzero");
+    // The finest MG level of each AMR level keeps sigma for compRHS,
+    // updateVelocity, reflux, etc.
+    for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev) {
+        m_sigma[amrlev][0][0]->setVal(a_sigma);
+    }
+    m_const_sigma = a_sigma;
 }
 
 void
@@ -651,7 +665,18 @@ MLNodeLaplacian::averageDownCoeffs ()
 {
     BL_PROFILE("MLNodeLaplacian::averageDownCoeffs()");
 
-    if (m_coarsening_strategy == CoarseningStrategy::Sigma)
+    if (useConstSigma())
+    {
+        // Nothing is stored on the coarse MG levels.
+        for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev) {
+            for (int mglev = 1; mglev < m_num_mg_levels[amrlev]; ++mglev) {
+                for (auto& sig : m_sigma[amrlev][mglev]) {
+                    sig.reset();
+                }
+            }
+        }
+    }
+    else if (m_coarsening_strategy == CoarseningStrategy::Sigma)
     {
         for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
         {
@@ -685,7 +710,7 @@ MLNodeLaplacian::averageDownCoeffs ()
 
     for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
     {
-        if (m_use_harmonic_average) {
+        if (m_use_harmonic_average && !useConstSigma()) {
             int mglev = 0;
             FillBoundaryCoeff(*m_sigma[amrlev][mglev][0], m_geom[amrlev][mglev]);
             for (mglev = 1; mglev < m_num_mg_levels[amrlev]; ++mglev)
@@ -725,7 +750,7 @@ MLNodeLaplacian::averageDownCoeffsToCoarseAmrLevel (int flev)
 void
 MLNodeLaplacian::averageDownCoeffsSameAmrLevel (int amrlev)
 {
-    if (m_coarsening_strategy != CoarseningStrategy::Sigma) return;
+    if (m_coarsening_strategy != CoarseningStrategy::Sigma || useConstSigma()) return;
 
     const int nsigma = (m_use_harmonic_average) ? AMREX_SPACEDIM : 1;
 
@@ -1127,6 +1152,7 @@ MLNodeLaplacian::interpolation (int amrlev, int fmglev, MultiFab& fine, const Mu
 
     const auto& sigma = m_sigma[amrlev][fmglev];
     const auto& stencil = m_stencil[amrlev][fmglev];
+    const bool const_sigma = useConstSigma();
 
     bool need_parallel_copy = !amrex::isMFIterSafe(crse, fine);
     MultiFab cfine;
@@ -1157,6 +1183,13 @@ MLNodeLaplacian::interpolation (int amrlev, int fmglev, MultiFab& fine, const Mu
                 mlndlap_interpadd_rap(i,j,k,ffab,cfab,stfab,mfab);
             });
         }
+        else if (const_sigma)
+        {
+            AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bx, i, j, k,
+            {
+                mlndlap_interpadd_c(i,j,k,ffab,cfab,mfab);
+            });
+        }
         else if (m_use_harmonic_average && fmglev > 0)
         {
             AMREX_D_TERM(Array4<Real const> const& sxfab = sigma[0]->const_array(mfi);,
@@ -1281,6 +1314,7 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
 
     const auto& sigma = m_sigma[amrlev][mglev];
     const auto& stencil = m_stencil[amrlev][mglev];
+    const Real const_sigma = useConstSigma() ? m_const_sigma : 0.0;
     const auto dxinvarr = m_geom[amrlev][mglev].InvCellSizeArray();
 #if (AMREX_SPACEDIM == 2)
     bool is_rz = m_is_rz;
@@ -1306,6 +1340,20 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
                 mlndlap_adotx_sten(i,j,k,yarr,xarr,stenarr,dmskarr);
             });
         }
+        else if (const_sigma != 0.0)
+        {
+#if (AMREX_SPACEDIM == 2)
+            AMREX_HOST_DEVICE_PARALLEL_FOR_3D ( bx, i, j, k,
+            {
+                mlndlap_adotx_c(i,j,k,yarr,xarr,const_sigma,dmskarr, is_rz, dxinvarr);
+            });
+#else
+            AMREX_HOST_DEVICE_PARALLEL_FOR_3D ( bx, i, j, k,
+            {
+                mlndlap_adotx_c(i,j,k,yarr,xarr,const_sigma,dmskarr, dxinvarr);
+            });
+#endif
+        }
         else if (m_use_harmonic_average && mglev > 0)
         {
             AMREX_D_TERM(Array4<Real const> const& sxarr = sigma[0]->const_array(mfi);,
@@ -1350,6 +1398,7 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
 
     const auto& sigma = m_sigma[amrlev][mglev];
     const auto& stencil = m_stencil[amrlev][mglev];
+    const Real const_sigma = useConstSigma() ? m_const_sigma : 0.0;
     const auto dxinvarr = m_geom[amrlev][mglev].InvCellSizeArray();
 #if (AMREX_SPACEDIM == 2)
     bool is_rz = m_is_rz;
@@ -1386,6 +1435,33 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
                 }
             }
         }
+        else if (const_sigma != 0.0)
+        {
+            for (MFIter mfi(sol); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.validbox();
+                Array4<Real> const& solarr = sol.array(mfi);
+                Array4<Real const> const& rhsarr = rhs.const_array(mfi);
+                Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+                Array4<Real> const& Axarr = Ax.array(mfi);
+
+                for (int ns = 0; ns < nsweeps; ++ns) {
+                    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    {
+                        mlndlap_adotx_c(i,j,k,Axarr,solarr,const_sigma,dmskarr,
+#if (AMREX_SPACEDIM == 2)
+                                        is_rz,
+#endif
+                                        dxinvarr);
+                    });
+                    AMREX_LAUNCH_DEVICE_LAMBDA ( bx, tbx,
+                    {
+                        mlndlap_jacobi_c (tbx, solarr, Axarr, rhsarr, const_sigma,
+                                          dmskarr, dxinvarr);
+                    });
+                }
+            }
+        }
         else if (m_use_harmonic_average && mglev > 0)
         {
             for (MFIter mfi(sol); mfi.isValid(); ++mfi)
@@ -1471,6 +1547,28 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
                     }
                 }
             }
+            else if (const_sigma != 0.0)
+            {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+                for (MFIter mfi(sol); mfi.isValid(); ++mfi)
+                {
+                    const Box& bx = mfi.validbox();
+                    Array4<Real> const& solarr = sol.array(mfi);
+                    Array4<Real const> const& rhsarr = rhs.const_array(mfi);
+                    Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+
+                    for (int ns = 0; ns < nsweeps; ++ns) {
+                        mlndlap_gauss_seidel_c(bx, solarr, rhsarr,
+                                               const_sigma, dmskarr, dxinvarr
+#if (AMREX_SPACEDIM == 2)
+                                               ,is_rz
+#endif
+                            );
+                    }
+                }
+            }
             else if (m_use_harmonic_average && mglev > 0)
             {
 #ifdef _OPENMP
@@ -1545,6 +1643,23 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
                     mlndlap_jacobi_sten(bx,solarr,Axarr,rhsarr,stenarr,dmskarr);
                 }
             }
+            else if (const_sigma != 0.0)
+            {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+                for (MFIter mfi(sol,true); mfi.isValid(); ++mfi)
+                {
+                    const Box& bx = mfi.tilebox();
+                    Array4<Real> const& solarr = sol.array(mfi);
+                    Array4<Real const> const& Axarr = Ax.const_array(mfi);
+                    Array4<Real const> const& rhsarr = rhs.const_array(mfi);
+                    Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+
+                    mlndlap_jacobi_c (bx, solarr, Axarr, rhsarr, const_sigma,
+                                      dmskarr, dxinvarr);
+                }
+            }
             else if (m_use_harmonic_average && mglev > 0)
             {
 #ifdef _OPENMP
@@ -1594,6 +1709,7 @@ MLNodeLaplacian::normalize (int amrlev, int mglev, MultiFab& mf) const
 
     const auto& sigma = m_sigma[amrlev][mglev];
     const auto& stencil = m_stencil[amrlev][mglev];
+    const Real const_sigma = useConstSigma() ? m_const_sigma : 0.0;
     const auto dxinv = m_geom[amrlev][mglev].InvCellSizeArray();
     const iMultiFab& dmsk = *m_dirichlet_mask[amrlev][mglev];
     const Real s0_norm0 = m_s0_norm0[amrlev][mglev];
@@ -1614,6 +1730,13 @@ MLNodeLaplacian::normalize (int amrlev, int mglev, MultiFab& mf) const
                 mlndlap_normalize_sten(tbx,arr,stenarr,dmskarr,s0_norm0);
             });
         }
+        else if (const_sigma != 0.0)
+        {
+            AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( bx, tbx,
+            {
+                mlndlap_normalize_c(tbx,arr,const_sigma,dmskarr,dxinv);
+            });
+        }
         else if (m_use_harmonic_average && mglev > 0)
         {
             AMREX_D_TERM(Array4<Real const> const& sxarr = sigma[0]->const_array(mfi);,
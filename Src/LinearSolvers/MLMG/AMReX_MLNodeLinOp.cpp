@@ -140,9 +140,7 @@ MLNodeLinOp::smooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
 Real
 MLNodeLinOp::xdoty (int amrlev, int mglev, const MultiFab& x, const MultiFab& y, bool local) const
 {
-    AMREX_ASSERT(amrlev==0);
-    AMREX_ASSERT(mglev+1==m_num_mg_levels[0] || mglev==0);
-    const auto& mask = (mglev+1 == m_num_mg_levels[0]) ? m_bottom_dot_mask : m_coarse_dot_mask;
+    const auto& mask = *dotMask(amrlev, mglev);
     const int ncomp = y.nComp();
     const int nghost = 0;
     MultiFab tmp(x.boxArray(), x.DistributionMap(), ncomp, 0);
@@ -157,6 +155,14 @@ MLNodeLinOp::xdoty (int amrlev, int mglev, const MultiFab& x, const MultiFab& y,
     return result;
 }
 
+const MultiFab*
+MLNodeLinOp::dotMask (int amrlev, int mglev) const
+{
+    AMREX_ASSERT(amrlev==0);
+    AMREX_ASSERT(mglev+1==m_num_mg_levels[0] || mglev==0);
+    return (mglev+1 == m_num_mg_levels[0]) ? &m_bottom_dot_mask : &m_coarse_dot_mask;
+}
+
 void
 MLNodeLinOp::applyInhomogNeumannTerm (int amrlev, MultiFab& rhs) const
 {
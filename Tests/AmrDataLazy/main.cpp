@@ -0,0 +1,197 @@
+// --------------------------------------------------------------------
+// main.cpp
+// --------------------------------------------------------------------
+//   this file does the following:
+//     writes a two level plotfile, reads it with AmrData in eager and in
+//     lazy mode with a small fab cache, and checks that FillVar and MinMax
+//     give the same results, and that the fabs returned by GetGrids stay
+//     valid while the cache is trimmed.
+// --------------------------------------------------------------------
+#include <cmath>
+#include <limits>
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_PlotFileUtil.H>
+#include <AMReX_AmrData.H>
+
+using namespace amrex;
+
+namespace {
+
+void WriteTestPlotfile (const std::string& pltfile, int n_cell, int max_grid_size)
+{
+    const int nlevs = 2;
+    const IntVect rr(2);
+    Vector<Geometry> geom(nlevs);
+    Vector<BoxArray> ba(nlevs);
+    Vector<MultiFab> mf(nlevs);
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+
+    Box domain(IntVect(0), IntVect(n_cell-1));
+    for (int lev = 0; lev < nlevs; ++lev) {
+        geom[lev].define(domain, rb, CoordSys::cartesian, is_periodic);
+        if (lev == 0) {
+            ba[lev].define(domain);
+        } else {
+            ba[lev].define(amrex::grow(domain, -domain.length(0)/4));
+        }
+        ba[lev].maxSize(max_grid_size);
+        mf[lev].define(ba[lev], DistributionMapping(ba[lev]), 2, 0);
+
+        const auto dx = geom[lev].CellSizeArray();
+        for (MFIter mfi(mf[lev]); mfi.isValid(); ++mfi) {
+            Array4<Real> const& a = mf[lev].array(mfi);
+            LoopOnCpu(mfi.validbox(), [=] (int i, int j, int k) noexcept
+            {
+                Real x = (i+0.5)*dx[0];
+                Real y = (j+0.5)*dx[1];
+#if (AMREX_SPACEDIM == 3)
+                Real z = (k+0.5)*dx[2];
+#else
+                Real z = 0.;
+#endif
+                a(i,j,k,0) = std::sin(6.*x) * std::cos(5.*y) + z + lev;
+                a(i,j,k,1) = x*y - z*z;
+            });
+        }
+        domain.refine(rr);
+    }
+
+    WriteMultiLevelPlotfile(pltfile, nlevs, GetVecOfConstPtrs(mf), {"a", "b"},
+                            geom, 0.0, Vector<int>(nlevs, 0), Vector<IntVect>(nlevs-1, rr));
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        std::string pltfile("plt_amrdata_lazy");
+        int n_cell = 32;
+        int max_grid_size = 8;
+        Long cache_target = 64*1024;
+        {
+            ParmParse pp;
+            pp.query("pltfile", pltfile);
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("cache_target", cache_target);
+        }
+
+        WriteTestPlotfile(pltfile, n_cell, max_grid_size);
+        ParallelDescriptor::Barrier();
+
+        AmrData::SetLazyLoading(false);
+        AmrData eager;
+        eager.ReadData(pltfile, Amrvis::NEWPLT);
+
+        AmrData::SetLazyLoading(true);
+        AmrData::SetFabCacheTarget(cache_target);
+        AmrData lazy;
+        lazy.ReadData(pltfile, Amrvis::NEWPLT);
+
+        const int ioproc = ParallelDescriptor::IOProcessorNumber();
+        const int finest = eager.FinestLevel();
+
+        // a slice of the finest level, held by the caller during the fills
+        Box held_box = eager.ProbDomain()[finest];
+        const int held_k = held_box.length(0)/2;
+        held_box.setSmall(0, held_k);
+        held_box.setBig  (0, held_k);
+        MultiFab& held = lazy.GetGrids(finest, 0, held_box);
+        MultiFab& held_eager = eager.GetGrids(finest, 0, held_box);
+
+        Real max_diff = 0.0;
+        bool minmax_ok = true;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int iv = 0; iv < eager.NComp(); ++iv) {
+                const std::string& var = eager.PlotVarNames()[iv];
+                for (int lev = 0; lev <= finest; ++lev) {
+                    const Box& dom = eager.ProbDomain()[lev];
+                    // a plane in each direction, and the whole domain
+                    for (int d = 0; d <= AMREX_SPACEDIM; ++d) {
+                        Box b = dom;
+                        if (d < AMREX_SPACEDIM) {
+                            const int k = (dom.smallEnd(d)+dom.bigEnd(d))/2 + pass;
+                            b.setSmall(d, k);
+                            b.setBig  (d, k);
+                        }
+                        FArrayBox *fab_e = nullptr, *fab_l = nullptr;
+                        if (ParallelDescriptor::MyProc() == ioproc) {
+                            fab_e = new FArrayBox(b, 1);
+                            fab_l = new FArrayBox(b, 1);
+                        }
+                        eager.FillVar(fab_e, b, lev, var, ioproc);
+                        lazy.FillVar (fab_l, b, lev, var, ioproc);
+                        if (fab_e) {
+                            fab_e->minus<RunOn::Host>(*fab_l);
+                            max_diff = std::max(max_diff, fab_e->norm<RunOn::Host>(0));
+                            delete fab_e;
+                            delete fab_l;
+                        }
+
+                        Real emin, emax, lmin, lmax;
+                        const bool ve = eager.MinMax(b, var, lev, emin, emax);
+                        const bool vl = lazy.MinMax (b, var, lev, lmin, lmax);
+                        if (ve != vl || emin != lmin || emax != lmax) {
+                            minmax_ok = false;
+                        }
+                    }
+                }
+            }
+        }
+
+        // fill every plane of the coarse level, which evicts the fine fabs
+        {
+            const Box& dom = eager.ProbDomain()[0];
+            for (int k = dom.smallEnd(0); k <= dom.bigEnd(0); ++k) {
+                Box b = dom;
+                b.setSmall(0, k);
+                b.setBig  (0, k);
+                FArrayBox* fab = nullptr;
+                if (ParallelDescriptor::MyProc() == ioproc) {
+                    fab = new FArrayBox(b, 1);
+                }
+                lazy.FillVar(fab, b, 0, eager.PlotVarNames()[1], ioproc);
+                delete fab;
+            }
+        }
+
+        // the fabs returned by GetGrids must not have been freed
+        Real held_diff = 0.0;
+        for (MFIter mfi(held_eager); mfi.isValid(); ++mfi) {
+            const Box& b = mfi.validbox() & held_box;
+            if (b.ok()) {
+                if (held[mfi].dataPtr() == nullptr || ! held[mfi].box().contains(b)) {
+                    held_diff = std::numeric_limits<Real>::max();
+                    continue;
+                }
+                FArrayBox d(b, 1);
+                d.copy<RunOn::Host>(held_eager[mfi], b, 0, b, 0, 1);
+                d.minus<RunOn::Host>(held[mfi], b, b, 0, 0, 1);
+                held_diff = std::max(held_diff, d.norm<RunOn::Host>(0));
+            }
+        }
+
+        ParallelDescriptor::ReduceRealMax(max_diff);
+        ParallelDescriptor::ReduceRealMax(held_diff);
+        ParallelDescriptor::ReduceBoolAnd(minmax_ok);
+        Long cache_bytes = lazy.LoadedFabBytes();
+        ParallelDescriptor::ReduceLongMax(cache_bytes);
+
+        amrex::Print() << "FillVar max difference:   " << max_diff << "\n"
+                       << "GetGrids max difference:  " << held_diff << "\n"
+                       << "MinMax agree:             " << minmax_ok << "\n"
+                       << "lazy cache bytes:         " << cache_bytes << "\n";
+
+        if (max_diff != 0.0 || held_diff != 0.0 || !minmax_ok) {
+            amrex::Abort("AmrDataLazy failed");
+        }
+        amrex::Print() << "AmrDataLazy passed\n";
+    }
+    amrex::Finalize();
+}
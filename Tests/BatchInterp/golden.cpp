@@ -0,0 +1,237 @@
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_BCRec.H>
+#include <AMReX_Interpolater.H>
+
+using namespace amrex;
+
+namespace {
+
+struct GoldenValues
+{
+    const char* name;
+    int coord;
+    int ratio;
+    Real sums[8]; // (sum, weighted sum) of each of the 4 components
+};
+
+// Generated with the Fortran AMReX_INTERP_{2,3}D.F90 kernels, before they were
+// ported to C++, by running this test with golden.print = 1.
+const GoldenValues golden[] = {
+#if (AMREX_SPACEDIM == 3)
+    {"PCInterp", 0, 2, {4620.257630012632, 32337.744047986118, 4084.1407242037144, 28577.564388429222, 3963.461152706077, 27732.014154998225, 4369.1711570122852, 30591.340087048367}},
+    {"PCInterp", 0, 4, {36962.061040101158, 258717.77740606418, 32673.125793629348, 228714.14033349915, 31707.689221648274, 221945.64593897649, 34953.369256098558, 244674.07703753407}},
+    {"NodeBilinear", 0, 2, {6123.1500173215327, 42878.215545079322, 5814.0728502136153, 40692.897692024788, 6017.3077548346473, 42130.484476326936, 6546.001497141805, 45817.436801655545}},
+    {"NodeBilinear", 0, 4, {43338.029475238014, 303367.4737872174, 40878.775802340206, 286132.48515358625, 42495.867709604208, 297451.40810572176, 46702.558355092959, 326920.80123607698}},
+    {"FaceLinear", 0, 2, {5044.3427657815118, 35320.623837625259, 4679.5416124135663, 32738.477525545775, 4745.438940186049, 33225.583499667926, 5181.4490498460173, 36275.409867057228}},
+    {"FaceLinear", 0, 4, {38721.194500897254, 271012.17492836725, 35628.412197027086, 249389.49303783788, 36187.089403295417, 253342.10891629776, 39883.580872730527, 279192.22920128261}},
+    {"CellConservativeLinear", 0, 2, {4620.2576300126384, 32341.030775935611, 4084.1407242037135, 28575.176917890956, 3963.461152706092, 27724.85402589204, 4369.1711570123061, 30588.377753345136}},
+    {"CellConservativeLinear", 0, 4, {36962.06104010086, 258723.10448689049, 32673.125793629915, 228709.35771549176, 31707.689221648794, 221941.33086191726, 34953.3692560985, 244676.21936958973}},
+    {"CellConservativeLinear(lincc)", 0, 2, {4620.2576300126302, 32341.996407191982, 4084.1407242037239, 28582.303653315874, 3963.4611527060961, 27726.466352222622, 4369.1711570122952, 30592.547592393097}},
+    {"CellConservativeLinear(lincc)", 0, 4, {36962.061040101551, 258725.22508939888, 32673.125793630043, 228702.54036578623, 31707.689221648274, 221941.68565479617, 34953.369256098573, 244680.54251782267}},
+    {"CellBilinear", 0, 2, {4614.0278812427123, 32298.125988100757, 4117.5498026117921, 28807.937817464121, 4005.7929056776275, 28020.73183709673, 4381.5059660881643, 30677.537982405545}},
+    {"CellBilinear", 0, 4, {36912.223049941778, 258371.62581353745, 32940.398420894315, 230576.17398735002, 32046.343245421125, 224315.89996623565, 35052.047728705453, 245372.13642926831}},
+    {"CellConservativeProtected", 0, 2, {-512.19906154509374, -3561.5818633224776, -225.92963789813814, -1595.0183079911071, -286.26942364695554, -1989.3662076510043, -83.414421493848408, -580.70646913494693}},
+    {"CellConservativeProtected", 0, 4, {-4097.5924923607399, -28691.098164715615, -1807.4371031851028, -12650.930173172703, -2290.1553891756507, -16036.975062240585, -667.31537195078897, -4672.892178008864}},
+    {"CellConservativeQuartic", 0, 2, {4620.2576300126329, 32341.881555712214, 4084.1407242037239, 28573.80687096791, 3963.4611527060897, 27724.050436598416, 4369.171157012307, 30591.427463322609}},
+#elif (AMREX_SPACEDIM == 2)
+    {"PCInterp", 0, 2, {409.5890803783355, 2872.3997539432867, 359.4846527377648, 2495.6969677437751, 326.40314998219446, 2272.9128442868573, 340.75955318192968, 2418.2950108711007}},
+    {"PCInterp", 0, 4, {1638.3563215133508, 11460.771953122166, 1437.9386109510629, 10046.732800674876, 1305.6125999287767, 9149.5272404665557, 1363.0382127277185, 9556.3917268787518}},
+    {"PCInterp", 1, 2, {409.5890803783355, 2872.3997539432867, 359.4846527377648, 2495.6969677437751, 326.40314998219446, 2272.9128442868573, 340.75955318192968, 2418.2950108711007}},
+    {"PCInterp", 1, 4, {1638.3563215133508, 11460.771953122166, 1437.9386109510629, 10046.732800674876, 1305.6125999287767, 9149.5272404665557, 1363.0382127277185, 9556.3917268787518}},
+    {"NodeBilinear", 0, 2, {496.650643690295, 3465.2970116600168, 454.9700169533358, 3168.5945257968583, 445.58773461926262, 3136.0336390144084, 477.12982379741004, 3355.0463075313505}},
+    {"NodeBilinear", 0, 4, {1839.4826811199491, 12877.155862962583, 1667.7964906789591, 11658.986995522017, 1629.1500393733086, 11382.361175380673, 1759.0746963061724, 12338.028349604065}},
+    {"NodeBilinear", 1, 2, {496.650643690295, 3465.2970116600168, 454.9700169533358, 3168.5945257968583, 445.58773461926262, 3136.0336390144084, 477.12982379741004, 3355.0463075313505}},
+    {"NodeBilinear", 1, 4, {1839.4826811199491, 12877.155862962583, 1667.7964906789591, 11658.986995522017, 1629.1500393733086, 11382.361175380673, 1759.0746963061724, 12338.028349604065}},
+    {"FaceLinear", 0, 2, {441.73245108189263, 3085.8650459764513, 400.18369971035929, 2805.9312396133951, 385.12852193194414, 2702.0637215532774, 410.40857876561273, 2875.926434378548}},
+    {"FaceLinear", 0, 4, {1703.9728274258541, 11900.694345960621, 1527.8477771027033, 10688.24391441835, 1464.0289171774914, 10260.102384731097, 1571.1910131497068, 11028.19618882784}},
+    {"FaceLinear", 1, 2, {441.73245108189263, 3085.8650459764513, 400.18369971035929, 2805.9312396133951, 385.12852193194414, 2702.0637215532774, 410.40857876561273, 2875.926434378548}},
+    {"FaceLinear", 1, 4, {1703.9728274258541, 11900.694345960621, 1527.8477771027033, 10688.24391441835, 1464.0289171774914, 10260.102384731097, 1571.1910131497068, 11028.19618882784}},
+    {"CellConservativeLinear", 0, 2, {409.58908037833532, 2871.9619779312434, 359.4846527377648, 2498.5828264940878, 326.40314998219463, 2269.765917940209, 340.75955318192973, 2409.6506227230011}},
+    {"CellConservativeLinear", 0, 4, {1638.3563215133429, 11461.134593577801, 1437.938610951061, 10052.074701786973, 1305.6125999287772, 9162.6258804018362, 1363.0382127277176, 9562.2451973839034}},
+    {"CellConservativeLinear", 1, 2, {407.61294717731545, 2858.5526561595702, 359.48312150309039, 2498.6950807040589, 326.86214731265136, 2272.8628203973672, 340.72846446147543, 2410.7329557201424}},
+    {"CellConservativeLinear", 1, 4, {1628.4887460660473, 11392.41631045832, 1437.9935500386837, 10052.675608400068, 1307.8658606652734, 9178.2508225990841, 1362.8827691254462, 9561.6466541981881}},
+    {"CellConservativeLinear(lincc)", 0, 2, {409.58908037833544, 2871.6826833425857, 359.48465273776463, 2500.3447691035894, 326.40314998219452, 2273.0638906559761, 340.75955318192979, 2412.1935847866412}},
+    {"CellConservativeLinear(lincc)", 0, 4, {1638.3563215133445, 11460.028776066329, 1437.9386109510585, 10045.532304709714, 1305.6125999287785, 9158.6429133640449, 1363.0382127277178, 9552.988599304741}},
+    {"CellConservativeLinear(lincc)", 1, 2, {409.39410684911479, 2870.6625999182052, 359.34711933296563, 2499.4796964274851, 326.33216404898627, 2272.6521357259767, 340.90424308890186, 2413.5945113685807}},
+    {"CellConservativeLinear(lincc)", 1, 4, {1637.3814538672402, 11453.49843787934, 1437.2509439270625, 10040.935257818604, 1305.2576702627377, 9156.2367888266144, 1363.7616622625778, 9558.2990513931363}},
+    {"CellBilinear", 0, 2, {407.39999201240323, 2855.9706787705436, 360.76774584454427, 2508.1042877249238, 329.97875467659946, 2294.6531457652359, 343.34027499766989, 2429.4524245503476}},
+    {"CellBilinear", 0, 4, {1629.5999680496141, 11398.374292698192, 1443.0709833781757, 10085.143017652215, 1319.9150187063967, 9259.1581454768329, 1373.3610999906798, 9635.6487915029084}},
+    {"CellBilinear", 1, 2, {407.39999201240323, 2855.9706787705436, 360.76774584454427, 2508.1042877249238, 329.97875467659946, 2294.6531457652359, 343.34027499766989, 2429.4524245503476}},
+    {"CellBilinear", 1, 4, {1629.5999680496141, 11398.374292698192, 1443.0709833781757, 10085.143017652215, 1319.9150187063967, 9259.1581454768329, 1373.3610999906798, 9635.6487915029084}},
+    {"CellQuadratic", 0, 2, {409.0366242356821, 2867.9040753923309, 360.12242107041197, 2503.1304025146333, 327.30551866126035, 2276.2107140206731, 341.2066218061006, 2414.0394784325076}},
+    {"CellQuadratic", 0, 4, {1635.5940408000738, 11441.088707441286, 1441.1274526142954, 10072.381244439799, 1310.124443324107, 9191.30412922695, 1365.273555848574, 9580.7444472989937}},
+    {"CellQuadratic", 1, 2, {406.91814646460398, 2853.4153108342098, 359.23588666808462, 2497.3314922146055, 327.82592077493916, 2279.9644432418349, 341.37950683214478, 2416.251821817666}},
+    {"CellQuadratic", 1, 4, {1624.8596878058631, 11366.226126118239, 1436.6881994170815, 10042.088717831139, 1312.67699196852, 9208.9031133980534, 1366.1626038514182, 9586.6961447082667}},
+    {"CellConservativeProtected", 0, 2, {-35.05609864002033, -256.35179064381367, -9.2576736311176386, -58.16471065991724, -25.798425008902683, -176.22685570686986, -18.620223409035173, -125.14523269410367}},
+    {"CellConservativeProtected", 0, 4, {-140.22439456008127, -983.78603485860458, -37.030694524470547, -264.25009176719408, -103.19370003561068, -711.85951427463135, -74.480893636141062, -521.58151047064723}},
+    {"CellConservativeProtected", 1, 2, {-35.325108032453343, -257.40848913721879, -9.1802288554716114, -57.747195722955006, -26.144879176981732, -179.10486618696675, -18.53130980823466, -124.3472063802236}},
+    {"CellConservativeProtected", 1, 4, {-138.95753834600296, -974.84359961237533, -37.341457605715867, -266.4500637214864, -101.61608074028725, -701.3357235196479, -74.036325632138443, -518.48737596033527}},
+    {"CellConservativeQuartic", 0, 2, {409.58908037833532, 2871.8560507972138, 359.48465273776458, 2498.4812358301092, 326.40314998219469, 2269.7848239606669, 340.7595531819295, 2411.5940039451139}},
+    {"CellConservativeQuartic", 1, 2, {409.58908037833532, 2871.8560507972138, 359.48465273776458, 2498.4812358301092, 326.40314998219469, 2269.7848239606669, 340.7595531819295, 2411.5940039451139}},
+#endif
+};
+
+struct InterpCase
+{
+    const char* name;
+    Interpolater* mapper;
+    IndexType typ;
+    bool protect;
+};
+
+Real crse_value (int i, int j, int k, int n)
+{
+    return std::sin(0.7*i + 0.3*j + 0.2*k + n) + 0.1*i*j + 2.0;
+}
+
+// Interpolate a smooth coarse field onto the fine cells of the coarse cells
+// [0,5]^D next to the lo boundaries, and return the (sum, weighted sum) of
+// each component.
+Vector<Real> run_case (InterpCase const& c, int coord, int ratio_)
+{
+    const int ncomp = 4;
+    const IntVect ratio(ratio_);
+
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+    const Box cdomain(IntVect(0), IntVect(7));
+    Geometry cgeom(cdomain, rb, coord, is_periodic);
+    Geometry fgeom(amrex::refine(cdomain,ratio), rb, coord, is_periodic);
+
+    Vector<BCRec> bcs(ncomp);
+    for (int n = 0; n < ncomp; ++n) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            bcs[n].setLo(idim, (n % 2 == 0) ? BCType::foextrap : BCType::ext_dir);
+            bcs[n].setHi(idim, BCType::reflect_even);
+        }
+    }
+
+    const Box fine_region = amrex::convert(amrex::refine(Box(IntVect(0),IntVect(5)),ratio), c.typ);
+    const Box fdomain = amrex::convert(fgeom.Domain(), c.typ);
+    Vector<BCRec> bcr(ncomp);
+    amrex::setBC(fine_region, fdomain, 0, 0, ncomp, bcs, bcr);
+
+    FArrayBox crse(c.mapper->CoarseBox(fine_region, ratio), ncomp);
+    {
+        Array4<Real> const& a = crse.array();
+        const Box& cbx = crse.box();
+        if (c.protect) {
+            // the coarse correction and the fine state change sign
+            LoopOnCpu(cbx, ncomp, [=] (int i, int j, int k, int n) noexcept
+            {
+                a(i,j,k,n) = 0.5*std::sin(0.7*i + 0.3*j + 0.2*k + n);
+            });
+        } else {
+            LoopOnCpu(cbx, ncomp, [=] (int i, int j, int k, int n) noexcept
+            {
+                a(i,j,k,n) = crse_value(i,j,k,n);
+            });
+        }
+    }
+
+    FArrayBox fine(fine_region, ncomp);
+    fine.setVal<RunOn::Host>(-1.0);
+    c.mapper->interp(crse, 0, fine, 0, ncomp, fine_region, ratio,
+                     cgeom, fgeom, bcr, 0, 0, RunOn::Host);
+
+    if (c.protect) {
+        FArrayBox state(fine_region, ncomp);
+        Array4<Real> const& s = state.array();
+        LoopOnCpu(fine_region, ncomp, [=] (int i, int j, int k, int n) noexcept
+        {
+            s(i,j,k,n) = 0.3*std::sin(1.3*i + 0.7*j + 0.9*k + n);
+        });
+        CellConservativeProtected* mapper = static_cast<CellConservativeProtected*>(c.mapper);
+        mapper->protect(crse, 0, fine, 0, state, 0, ncomp, fine_region, ratio,
+                        cgeom, fgeom, bcr, RunOn::Host);
+    }
+
+    Vector<Real> sums(2*ncomp, 0.0);
+    Array4<Real const> const& f = fine.const_array();
+    LoopOnCpu(fine_region, ncomp, [&] (int i, int j, int k, int n) noexcept
+    {
+        const int w = 1 + ((3*i + 5*j + 7*k + 11*n + 39) % 13);
+        sums[2*n  ] += f(i,j,k,n);
+        sums[2*n+1] += f(i,j,k,n) * w;
+    });
+    return sums;
+}
+
+}
+
+// Compares the results of all the Interpolaters with the values of the
+// Fortran kernels that they replaced.
+Real test_golden ()
+{
+    bool print = false;
+    {
+        ParmParse pp("golden");
+        pp.query("print", print);
+    }
+
+    const IndexType xface(IntVect::TheDimensionVector(0));
+    Vector<InterpCase> cases = {
+        {"PCInterp",                   &pc_interp,            IndexType::TheCellType(), false},
+        {"NodeBilinear",               &node_bilinear_interp, IndexType::TheNodeType(), false},
+        {"FaceLinear",                 &face_linear_interp,   xface,                    false},
+        {"CellConservativeLinear",     &cell_cons_interp,     IndexType::TheCellType(), false},
+        {"CellConservativeLinear(lincc)", &lincc_interp,      IndexType::TheCellType(), false},
+        {"CellBilinear",               &cell_bilinear_interp, IndexType::TheCellType(), false},
+#if (AMREX_SPACEDIM == 2)
+        {"CellQuadratic",              &quadratic_interp,     IndexType::TheCellType(), false},
+#endif
+        {"CellConservativeProtected",  &protected_interp,     IndexType::TheCellType(), true },
+        {"CellConservativeQuartic",    &quartic_interp,       IndexType::TheCellType(), false}
+    };
+
+#if (AMREX_SPACEDIM == 2)
+    const Vector<int> coords = {0, 1};
+#else
+    const Vector<int> coords = {0};
+#endif
+
+    Real max_rel_diff = 0.0;
+    int igolden = 0;
+    for (auto const& c : cases) {
+        for (int coord : coords) {
+            for (int ratio : {2, 4}) {
+                if (ratio != 2 && c.mapper == &quartic_interp) continue;
+
+                const Vector<Real> sums = run_case(c, coord, ratio);
+
+                if (print) {
+                    std::ostringstream os;
+                    os << std::setprecision(17)
+                       << "    {\"" << c.name << "\", " << coord << ", " << ratio << ", {";
+                    for (int i = 0; i < sums.size(); ++i) {
+                        os << ((i == 0) ? "" : ", ") << sums[i];
+                    }
+                    os << "}},\n";
+                    amrex::Print() << os.str();
+                    continue;
+                }
+
+                GoldenValues const& g = golden[igolden++];
+                AMREX_ALWAYS_ASSERT(std::string(g.name) == c.name && g.coord == coord
+                                    && g.ratio == ratio);
+                Real d = 0.0;
+                for (int i = 0; i < sums.size(); ++i) {
+                    d = std::max(d, std::abs(sums[i]-g.sums[i]) / (1.0 + std::abs(g.sums[i])));
+                }
+                amrex::Print() << c.name << " coord " << coord << " ratio " << ratio
+                               << ": max relative difference from Fortran = " << d << "\n";
+                max_rel_diff = std::max(max_rel_diff, d);
+            }
+        }
+    }
+
+    return max_rel_diff;
+}
@@ -0,0 +1,186 @@
+
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_PhysBCFunct.H>
+#include <AMReX_FillPatchUtil.H>
+
+using namespace amrex;
+
+void test ();
+Real test_golden ();
+
+int main(int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    test();
+    amrex::Finalize();
+}
+
+namespace {
+
+// InterpFromCoarseLevel as it was before the patches were interpolated
+// with a single Interpolater::BatchInterp call: one interp call per box.
+void InterpFromCoarseLevelPerBox (MultiFab& mf, IntVect const& nghost,
+                                  const MultiFab& cmf, int scomp, int dcomp, int ncomp,
+                                  const Geometry& cgeom, const Geometry& fgeom,
+                                  const IntVect& ratio, Interpolater* mapper,
+                                  const Vector<BCRec>& bcs, int bcscomp)
+{
+    const InterpolaterBoxCoarsener& coarsener = mapper->BoxCoarsener(ratio);
+
+    const BoxArray& ba = mf.boxArray();
+    const DistributionMapping& dm = mf.DistributionMap();
+    const IndexType& typ = ba.ixType();
+
+    Box fdomain = fgeom.Domain();
+    fdomain.convert(typ);
+
+    Box fdomain_g(fdomain);
+    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+        if (fgeom.isPeriodic(i)) {
+            fdomain_g.grow(i,nghost[i]);
+        }
+    }
+
+    BoxArray ba_crse_patch(ba.size());
+    for (int i = 0, N = ba.size(); i < N; ++i)
+    {
+        Box bx = amrex::convert(amrex::grow(ba[i],nghost), typ);
+        bx &= fdomain_g;
+        ba_crse_patch.set(i, coarsener.doit(bx));
+    }
+
+    MultiFab mf_crse_patch(ba_crse_patch, dm, ncomp, 0);
+    mf_set_domain_bndry (mf_crse_patch, cgeom);
+    mf_crse_patch.copy(cmf, scomp, 0, ncomp, cgeom.periodicity());
+
+    int idummy1=0, idummy2=0;
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    {
+        Vector<BCRec> bcr(ncomp);
+
+        for (MFIter mfi(mf_crse_patch); mfi.isValid(); ++mfi)
+        {
+            FArrayBox& sfab = mf_crse_patch[mfi];
+            FArrayBox& dfab = mf[mfi];
+            Box dfab_bx = dfab.box();
+            dfab_bx.grow(nghost-mf.nGrowVect());
+            const Box& dbx = dfab_bx & fdomain_g;
+
+            amrex::setBC(dbx,fdomain,bcscomp,0,ncomp,bcs,bcr);
+
+            mapper->interp(sfab, 0, dfab, dcomp, ncomp, dbx, ratio,
+                           cgeom, fgeom, bcr, idummy1, idummy2, RunOn::Gpu);
+        }
+    }
+}
+
+}
+
+// Interpolater::BatchInterp interpolates all the patches of a level in one
+// call.  This checks that InterpFromCoarseLevel, which uses it, gives
+// the same result, bit for bit, as the per-box interp calls it replaced, and
+// that the interpolaters still give the results of the Fortran kernels.
+void test ()
+{
+    int n_cell = 32;
+    int max_grid_size = 16;
+    int ncomp = 2;
+    int nghost = 2;
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("max_grid_size", max_grid_size);
+        pp.query("ncomp", ncomp);
+        pp.query("nghost", nghost);
+    }
+
+    const IntVect ratio(2);
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    // periodic in x only, so that both the periodic and the physical
+    // boundary code paths are used
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,0,0)};
+    const Box cdomain(IntVect(0), IntVect(n_cell-1));
+    const Box fdomain = amrex::refine(cdomain, ratio);
+    Geometry cgeom(cdomain, rb, 0, is_periodic);
+    Geometry fgeom(fdomain, rb, 0, is_periodic);
+
+    Vector<BCRec> bcs(ncomp);
+    for (int n = 0; n < ncomp; ++n) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (is_periodic[idim]) {
+                bcs[n].setLo(idim, BCType::int_dir);
+                bcs[n].setHi(idim, BCType::int_dir);
+            } else {
+                bcs[n].setLo(idim, (n == 0) ? BCType::foextrap : BCType::ext_dir);
+                bcs[n].setHi(idim, BCType::reflect_even);
+            }
+        }
+    }
+
+    PhysBCFunctNoOp physbc;
+    Real max_diff = 0.0;
+
+    const std::string names[] = {"CellConservativeLinear", "NodeBilinear"};
+    Interpolater* mappers[] = {&cell_cons_interp, &node_bilinear_interp};
+    const IndexType types[] = {IndexType::TheCellType(), IndexType::TheNodeType()};
+
+    for (int imap = 0; imap < 2; ++imap)
+    {
+        // the fine level covers a part of the domain, including the
+        // corners of the physical boundaries
+        BoxArray cba(cdomain);
+        cba.maxSize(max_grid_size);
+        cba.convert(types[imap]);
+        DistributionMapping cdm(cba);
+
+        Box fbx = fdomain;
+        fbx.setBig(0, fdomain.length(0)/2 + 5);
+        BoxArray fba(fbx);
+        fba.maxSize(max_grid_size);
+        fba.convert(types[imap]);
+        DistributionMapping fdm(fba);
+
+        MultiFab cmf(cba, cdm, ncomp, 0);
+        for (MFIter mfi(cmf); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            auto const a = cmf.array(mfi);
+            amrex::ParallelFor(bx, ncomp,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+            {
+                a(i,j,k,n) = std::sin(0.7*i + 0.3*j + 0.2*k + n) + 0.1*i*j;
+            });
+        }
+
+        MultiFab batched(fba, fdm, ncomp, nghost);
+        batched.setVal(-1.0);
+        amrex::InterpFromCoarseLevel(batched, 0.0, cmf, 0, 0, ncomp, cgeom, fgeom,
+                                     physbc, 0, physbc, 0, ratio, mappers[imap], bcs, 0);
+
+        MultiFab perbox(fba, fdm, ncomp, nghost);
+        perbox.setVal(-1.0);
+        InterpFromCoarseLevelPerBox(perbox, IntVect(nghost), cmf, 0, 0, ncomp,
+                                    cgeom, fgeom, ratio, mappers[imap], bcs, 0);
+
+        MultiFab::Subtract(batched, perbox, 0, 0, ncomp, nghost);
+        Real d = 0.0;
+        for (int n = 0; n < ncomp; ++n) {
+            d = std::max(d, batched.norm0(n, nghost));
+        }
+        amrex::Print() << names[imap] << ": max |BatchInterp - per box| = " << d << "\n";
+        max_diff = std::max(max_diff, d);
+    }
+
+    const Real golden_diff = test_golden();
+
+    if (max_diff != 0.0 || golden_diff > 1.e-13) {
+        amrex::Abort("BatchInterp failed");
+    }
+    amrex::Print() << "BatchInterp passed\n";
+}
@@ -0,0 +1,146 @@
+// --------------------------------------------------------------------
+// main.cpp
+// --------------------------------------------------------------------
+//   this file does the following:
+//     converts a two level hierarchy of cell-centered and face data with
+//     ghost cells to a Conduit Mesh Blueprint, checks it with the
+//     Blueprint verify, and checks that the zero copied ghost indicators
+//     stay valid while other hierarchies are converted.
+// --------------------------------------------------------------------
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Conduit_Blueprint.H>
+
+#include <conduit/conduit_blueprint.hpp>
+
+using namespace amrex;
+
+namespace {
+
+struct Hierarchy
+{
+    Vector<Geometry> geom;
+    Vector<MultiFab> cc;
+    Vector<MultiFab> fc;
+    Vector<IntVect> ref_ratio;
+};
+
+void MakeHierarchy (Hierarchy& h, int n_cell, int max_grid_size)
+{
+    const int nlevs = 2;
+    const IntVect rr(2);
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+
+    h.geom.resize(nlevs);
+    h.cc.resize(nlevs);
+    h.fc.resize(nlevs);
+    h.ref_ratio.assign(nlevs-1, rr);
+
+    Box domain(IntVect(0), IntVect(n_cell-1));
+    for (int lev = 0; lev < nlevs; ++lev) {
+        h.geom[lev].define(domain, rb, CoordSys::cartesian, is_periodic);
+        BoxArray ba = (lev == 0) ? BoxArray(domain)
+                                 : BoxArray(amrex::grow(domain, -domain.length(0)/4));
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+        h.cc[lev].define(ba, dm, 2, 1);
+        h.cc[lev].setVal(lev+1.0);
+        h.fc[lev].define(amrex::convert(ba, IntVect::TheDimensionVector(0)), dm, 1, 1);
+        h.fc[lev].setVal(-lev-1.0);
+        domain.refine(rr);
+    }
+}
+
+void ToBlueprint (const Hierarchy& h, conduit::Node& res)
+{
+    const int nlevs = h.cc.size();
+    MultiLevelToBlueprint(nlevs, amrex::GetVecOfConstPtrs(h.cc), {"a", "b"},
+                          h.geom, 0.0, Vector<int>(nlevs, 0), h.ref_ratio, res);
+    MultiLevelToBlueprint(nlevs, amrex::GetVecOfConstPtrs(h.fc), {"u"},
+                          h.geom, 0.0, Vector<int>(nlevs, 0), h.ref_ratio, res);
+}
+
+// Returns the number of local patches whose ghost indicator is wrong.
+int CheckGhostIndicator (const Hierarchy& h, const conduit::Node& res)
+{
+    int nbad = 0;
+    int offset = 0;
+    for (int lev = 0; lev < h.cc.size(); ++lev) {
+        const MultiFab& mf = h.cc[lev];
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            const std::string& patch_name = amrex::Concatenate("domain_", mfi.index()+offset, 6);
+            const conduit::Node& vals = res[patch_name + "/fields/ghost_indicator/values"];
+            const Long npts = mfi.fabbox().numPts();
+            const conduit::float64* p = vals.as_float64_ptr();
+            Long nghost = 0;
+            for (Long i = 0; i < vals.dtype().number_of_elements(); ++i) {
+                nghost += (p[i] == 1.0) ? 1 : 0;
+            }
+            if (vals.dtype().number_of_elements() != npts ||
+                nghost != npts - mfi.validbox().numPts()) {
+                ++nbad;
+            }
+        }
+        offset += mf.size();
+    }
+    return nbad;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        Hierarchy h;
+        MakeHierarchy(h, n_cell, max_grid_size);
+
+        conduit::Node res;
+        ToBlueprint(h, res);
+
+        int nbad = 0;
+        conduit::Node info;
+        if (!res.dtype().is_empty() && !conduit::blueprint::mesh::verify(res, info)) {
+            amrex::AllPrint() << info.to_json() << "\n";
+            ++nbad;
+        }
+        nbad += CheckGhostIndicator(h, res);
+
+        // the same grids give the same ghost indicators, which are not copied
+        conduit::Node res2;
+        ToBlueprint(h, res2);
+        if (h.cc[0].local_size() > 0) {
+            const std::string path("domain_" + amrex::Concatenate("", h.cc[0].IndexArray()[0], 6)
+                                   + "/fields/ghost_indicator/values");
+            if (res[path].data_ptr() != res2[path].data_ptr()) ++nbad;
+        }
+
+        // converting other grids, which are freed right away, does not free
+        // the ghost indicators of res
+        for (int i = 0; i < 12; ++i) {
+            Hierarchy other;
+            MakeHierarchy(other, n_cell, 4 + i%4);
+            conduit::Node other_res;
+            ToBlueprint(other, other_res);
+            nbad += CheckGhostIndicator(other, other_res);
+        }
+        nbad += CheckGhostIndicator(h, res);
+
+        ParallelDescriptor::ReduceIntSum(nbad);
+        if (nbad != 0) {
+            amrex::Abort("ConduitBlueprint failed");
+        }
+        amrex::Print() << "ConduitBlueprint passed\n";
+    }
+    amrex::Finalize();
+}
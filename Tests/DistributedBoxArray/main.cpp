@@ -0,0 +1,159 @@
+// --------------------------------------------------------------------
+// main.cpp
+// --------------------------------------------------------------------
+//   this file does the following:
+//     builds the FillBoundary and ParallelCopy metadata with and without
+//     the DistributedBoxArray rendezvous (fabarray.rendezvous), on
+//     BoxArrays with holes distributed such that some processes have no
+//     boxes, and checks that the results are the same.  It also flushes
+//     the cached metadata on one process only, so that the processes
+//     disagree on whether the metadata have to be built.
+// --------------------------------------------------------------------
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_MultiFab.H>
+
+using namespace amrex;
+
+namespace {
+
+// The boxes of domain chopped to max_grid_size, without every fifth one.
+BoxArray MakeBoxArray (const Box& domain, int max_grid_size)
+{
+    BoxArray ba(domain);
+    ba.maxSize(max_grid_size);
+    BoxList bl(domain.ixType());
+    for (int i = 0; i < ba.size(); ++i) {
+        if (i % 5 != 3) bl.push_back(ba[i]);
+    }
+    return BoxArray(bl);
+}
+
+// Every third process has no boxes.
+DistributionMapping MakeDM (const BoxArray& ba)
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+    Vector<int> active;
+    for (int p = 0; p < nprocs; ++p) {
+        if (nprocs == 1 || p % 3 != 1) active.push_back(p);
+    }
+    Vector<int> pmap(ba.size());
+    for (int i = 0; i < ba.size(); ++i) {
+        pmap[i] = active[(7*i) % active.size()];
+    }
+    return DistributionMapping(pmap);
+}
+
+void Fill (MultiFab& mf)
+{
+    mf.setVal(-1.0);
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        Array4<Real> const& a = mf.array(mfi);
+        LoopOnCpu(mfi.validbox(), mf.nComp(), [=] (int i, int j, int k, int n) noexcept
+        {
+            a(i,j,k,n) = i + 100.*j + 1.e4*k + 1.e6*n;
+        });
+    }
+}
+
+Real MaxDiff (const MultiFab& a, const MultiFab& b)
+{
+    MultiFab d(a.boxArray(), a.DistributionMap(), a.nComp(), a.nGrowVect());
+    MultiFab::Copy(d, a, 0, 0, a.nComp(), a.nGrowVect());
+    MultiFab::Subtract(d, b, 0, 0, a.nComp(), a.nGrowVect());
+    Real r = 0.0;
+    for (int n = 0; n < d.nComp(); ++n) {
+        r = std::max(r, d.norm0(n, d.nGrow()));
+    }
+    return r;
+}
+
+// Returns the results of the FillBoundary and the ParallelCopy, the second
+// time after flushing the metadata on one process.
+void Run (bool rendezvous, const Geometry& geom, const BoxArray& ba, const BoxArray& ba2,
+          Vector<MultiFab>& res)
+{
+    FabArrayBase::use_rendezvous = rendezvous;
+    FabArrayBase::flushFBCache();
+    FabArrayBase::flushCPCache();
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int myproc = ParallelDescriptor::MyProc();
+    const Periodicity& period = geom.periodicity();
+
+    const DistributionMapping dm = MakeDM(ba);
+    const DistributionMapping dm2 = MakeDM(ba2);
+    const BoxArray nba = amrex::convert(ba, IntVect::TheNodeVector());
+
+    MultiFab cc(ba, dm, 2, 2);
+    MultiFab nd(nba, dm, 1, 1);
+    MultiFab dst(ba2, dm2, 2, 1);
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        if (pass == 1) {
+            if (myproc == 0) cc.flushFB();
+            if (myproc == nprocs-1) nd.flushFB();
+            if (myproc == nprocs/2) dst.flushCPC();
+        }
+
+        Fill(cc);
+        cc.FillBoundary(period);
+
+        Fill(nd);
+        nd.FillBoundary(period, true);
+
+        dst.setVal(-2.0);
+        dst.ParallelCopy(cc, 0, 0, 2, IntVect(1), IntVect(1), period);
+
+        res.emplace_back(ba, dm, 2, 2);
+        MultiFab::Copy(res.back(), cc, 0, 0, 2, 2);
+        res.emplace_back(nba, dm, 1, 1);
+        MultiFab::Copy(res.back(), nd, 0, 0, 1, 1);
+        res.emplace_back(ba2, dm2, 2, 1);
+        MultiFab::Copy(res.back(), dst, 0, 0, 2, 1);
+    }
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 8;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        // periodic in x only
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,0,0)};
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        Geometry geom(domain, rb, CoordSys::cartesian, is_periodic);
+
+        const BoxArray ba = MakeBoxArray(domain, max_grid_size);
+        const BoxArray ba2 = MakeBoxArray(domain, max_grid_size+4);
+
+        Vector<MultiFab> ref, res;
+        Run(false, geom, ba, ba2, ref);
+        Run(true , geom, ba, ba2, res);
+
+        Real diff = 0.0;
+        for (int i = 0; i < ref.size(); ++i) {
+            diff = std::max(diff, MaxDiff(ref[i], res[i]));
+        }
+
+        amrex::Print() << "max difference with the rendezvous: " << diff << "\n";
+        if (diff != 0.0) {
+            amrex::Abort("DistributedBoxArray failed");
+        }
+        amrex::Print() << "DistributedBoxArray passed\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,156 @@
+
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_PhysBCFunct.H>
+#include <AMReX_FillPatchUtil.H>
+
+using namespace amrex;
+
+void test ();
+
+int main(int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    test();
+    amrex::Finalize();
+}
+
+// The time interpolation of FillPatchSingleLevel used to be done in a
+// temporary MultiFab on the source BoxArray, which was then copied with
+// ParallelCopy.  This checks that FillPatchSingleLevel and
+// ParallelCopyLinComb give the same result.
+void test ()
+{
+    int n_cell = 64;
+    int max_grid_size_src = 16;
+    int max_grid_size_dst = 24;
+    int ncomp = 3;
+    int nghost = 2;
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("max_grid_size_src", max_grid_size_src);
+        pp.query("max_grid_size_dst", max_grid_size_dst);
+        pp.query("ncomp", ncomp);
+        pp.query("nghost", nghost);
+    }
+
+    Box domain(IntVect(0), IntVect(n_cell-1));
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+    Geometry geom(domain, rb, 0, is_periodic);
+
+    BoxArray sba(domain);
+    sba.maxSize(max_grid_size_src);
+    DistributionMapping sdm(sba);
+
+    // A shifted destination BoxArray that does not line up with the
+    // source grids.  The reversed process map makes most copies remote.
+    BoxArray dba(amrex::shift(domain, IntVect(3)) & domain);
+    dba.maxSize(max_grid_size_dst);
+    Vector<int> pmap = DistributionMapping(dba).ProcessorMap();
+    std::reverse(pmap.begin(), pmap.end());
+    DistributionMapping ddm(std::move(pmap));
+
+    const int scomp = 1;
+    const int dcomp = 0;
+    MultiFab s0(sba, sdm, ncomp+scomp, 0);
+    MultiFab s1(sba, sdm, ncomp+scomp, 0);
+    for (MFIter mfi(s0); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        auto const a0 = s0.array(mfi);
+        auto const a1 = s1.array(mfi);
+        amrex::ParallelFor(bx, ncomp+scomp,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            a0(i,j,k,n) = std::sin(0.1*i + 0.2*j + 0.3*k + n);
+            a1(i,j,k,n) = std::cos(0.3*i + 0.1*j + 0.2*k - n);
+        });
+    }
+
+    const Real t0 = 0.0;
+    const Real t1 = 1.0;
+    PhysBCFunctNoOp physbc;
+    Real max_diff = 0.0;
+
+    for (Real time : {0.0, 0.3, 1.0})
+    {
+        // the old way, with a temporary MultiFab
+        MultiFab ref(dba, ddm, ncomp, nghost);
+        ref.setVal(-1.0);
+        {
+            MultiFab tmp(sba, sdm, ncomp, 0);
+            const Real alpha = (t1-time)/(t1-t0);
+            const Real beta = (time-t0)/(t1-t0);
+            for (MFIter mfi(tmp); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.validbox();
+                auto const sfab0 = s0.array(mfi);
+                auto const sfab1 = s1.array(mfi);
+                auto       dfab  = tmp.array(mfi);
+                if (time == t0) {
+                    amrex::ParallelFor(bx, ncomp,
+                    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                    {
+                        dfab(i,j,k,n) = sfab0(i,j,k,n+scomp);
+                    });
+                } else if (time == t1) {
+                    amrex::ParallelFor(bx, ncomp,
+                    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                    {
+                        dfab(i,j,k,n) = sfab1(i,j,k,n+scomp);
+                    });
+                } else {
+                    amrex::ParallelFor(bx, ncomp,
+                    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                    {
+                        dfab(i,j,k,n) = alpha*sfab0(i,j,k,n+scomp)
+                            +            beta*sfab1(i,j,k,n+scomp);
+                    });
+                }
+            }
+            ref.ParallelCopy(tmp, 0, dcomp, ncomp, IntVect(0), IntVect(nghost),
+                             geom.periodicity());
+        }
+
+        MultiFab mf(dba, ddm, ncomp, nghost);
+        mf.setVal(-1.0);
+        amrex::FillPatchSingleLevel(mf, time, {&s0,&s1}, {t0,t1}, scomp, dcomp, ncomp,
+                                    geom, physbc, 0);
+
+        MultiFab::Subtract(mf, ref, 0, 0, ncomp, nghost);
+        Real d = 0.0;
+        for (int n = 0; n < ncomp; ++n) {
+            d = std::max(d, mf.norm0(n, nghost));
+        }
+        amrex::Print() << "time = " << time << ": max |FillPatchSingleLevel - old| = "
+                       << d << "\n";
+        max_diff = std::max(max_diff, d);
+
+        if (time != t0 && time != t1)
+        {
+            const Real alpha = (t1-time)/(t1-t0);
+            const Real beta = (time-t0)/(t1-t0);
+            MultiFab lc(dba, ddm, ncomp, nghost);
+            lc.setVal(-1.0);
+            lc.ParallelCopyLinComb(alpha, s0, beta, s1, scomp, dcomp, ncomp,
+                                   IntVect(0), IntVect(nghost), geom.periodicity());
+            MultiFab::Subtract(lc, ref, 0, 0, ncomp, nghost);
+            Real dlc = 0.0;
+            for (int n = 0; n < ncomp; ++n) {
+                dlc = std::max(dlc, lc.norm0(n, nghost));
+            }
+            amrex::Print() << "time = " << time << ": max |ParallelCopyLinComb - old| = "
+                           << dlc << "\n";
+            max_diff = std::max(max_diff, dlc);
+        }
+    }
+
+    if (max_diff > 1.e-14) {
+        amrex::Abort("FillPatchTimeInterp failed");
+    }
+    amrex::Print() << "FillPatchTimeInterp passed\n";
+}
@@ -0,0 +1,224 @@
+//
+// Tests FFTPoisson.  With periodic boundaries, the solution is compared with
+// that of MLPoisson.  With open boundaries, it is compared, including two
+// ghost cells, with the free-space potential of a Gaussian charge, and its
+// ghost cells are compared with the solution on a larger domain.
+//
+
+#include <cmath>
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_MLPoisson.H>
+#include <AMReX_MLMG.H>
+#include <AMReX_FFTPoisson.H>
+
+using namespace amrex;
+
+namespace {
+
+const Real pi = 3.14159265358979323846;
+
+Real test_periodic (int n_cell, int max_grid_size)
+{
+    const Box domain(IntVect(0), IntVect(n_cell-1));
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+    Geometry geom(domain, rb, CoordSys::cartesian, is_periodic);
+
+    BoxArray ba(domain);
+    ba.maxSize(max_grid_size);
+    DistributionMapping dm(ba);
+
+    MultiFab rhs(ba, dm, 1, 0);
+    const auto dx = geom.CellSizeArray();
+    for (MFIter mfi(rhs); mfi.isValid(); ++mfi)
+    {
+        Array4<Real> const& r = rhs.array(mfi);
+        LoopOnCpu(mfi.validbox(), [=] (int i, int j, int k) noexcept
+        {
+            Real x = (i+0.5)*dx[0];
+            Real y = (j+0.5)*dx[1];
+#if (AMREX_SPACEDIM == 3)
+            Real z = (k+0.5)*dx[2];
+#else
+            Real z = 0.25; amrex::ignore_unused(k);
+#endif
+            r(i,j,k) = std::sin(2.*pi*x) * std::cos(4.*pi*y) * std::cos(2.*pi*z)
+                + 0.5*std::exp(-50.*((x-0.4)*(x-0.4)+(y-0.6)*(y-0.6)+(z-0.5)*(z-0.5)));
+        });
+    }
+    // The solvable part of rhs
+    rhs.plus(-rhs.sum()/domain.d_numPts(), 0, 1);
+
+    MultiFab phi_fft(ba, dm, 1, 1);
+    phi_fft.setVal(0.0);
+    FFTPoisson fft(geom, FFTPoisson::BC::periodic);
+    fft.solve(phi_fft, rhs);
+
+    MultiFab phi_mg(ba, dm, 1, 1);
+    phi_mg.setVal(0.0);
+    MLPoisson mlpoisson({geom}, {ba}, {dm});
+    mlpoisson.setDomainBC({AMREX_D_DECL(LinOpBCType::Periodic,
+                                        LinOpBCType::Periodic,
+                                        LinOpBCType::Periodic)},
+                          {AMREX_D_DECL(LinOpBCType::Periodic,
+                                        LinOpBCType::Periodic,
+                                        LinOpBCType::Periodic)});
+    mlpoisson.setLevelBC(0, nullptr);
+    MLMG mlmg(mlpoisson);
+    mlmg.setMaxIter(100);
+    mlmg.solve({&phi_mg}, {&rhs}, 1.e-12, 0.0);
+
+    // MLMG leaves the constant undetermined, FFTPoisson returns zero mean.
+    phi_mg.plus(-phi_mg.sum()/domain.d_numPts(), 0, 1);
+
+    MultiFab::Subtract(phi_mg, phi_fft, 0, 0, 1, 0);
+    return phi_mg.norm0() / phi_fft.norm0();
+}
+
+Real test_open (int n_cell, int max_grid_size, Real sigma)
+{
+    const Box domain(IntVect(0), IntVect(n_cell-1));
+    RealBox rb({AMREX_D_DECL(-1.,-1.,-1.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+    Geometry geom(domain, rb, CoordSys::cartesian, is_periodic);
+
+    BoxArray ba(domain);
+    ba.maxSize(max_grid_size);
+    DistributionMapping dm(ba);
+
+    const int ng = 2;
+    MultiFab rhs(ba, dm, 1, 0);
+    MultiFab exact(ba, dm, 1, ng);
+    const auto dx = geom.CellSizeArray();
+    for (MFIter mfi(exact); mfi.isValid(); ++mfi)
+    {
+        Array4<Real> const& r = rhs.array(mfi);
+        Array4<Real> const& e = exact.array(mfi);
+        const Box& vbx = mfi.validbox();
+        LoopOnCpu(mfi.fabbox(), [=] (int i, int j, int k) noexcept
+        {
+            Real x = -1. + (i+0.5)*dx[0];
+            Real y = -1. + (j+0.5)*dx[1];
+#if (AMREX_SPACEDIM == 3)
+            Real z = -1. + (k+0.5)*dx[2];
+#else
+            Real z = 0.; amrex::ignore_unused(k);
+#endif
+            const Real r2 = x*x + y*y + z*z;
+            const Real rr = std::sqrt(r2);
+            // Lap(e) = r for a normalized Gaussian charge r.
+#if (AMREX_SPACEDIM == 3)
+            if (vbx.contains(IntVect(i,j,k))) {
+                r(i,j,k) = std::exp(-r2/(sigma*sigma)) / (std::pow(pi,1.5)*sigma*sigma*sigma);
+            }
+            e(i,j,k) = (rr > 0.) ? -std::erf(rr/sigma)/(4.*pi*rr)
+                                 : -1./(2.*std::pow(pi,1.5)*sigma);
+#else
+            amrex::ignore_unused(vbx,r,e,rr);
+            amrex::Abort("FFTPoisson test: the open boundary check is 3D only");
+#endif
+        });
+    }
+
+    MultiFab phi(ba, dm, 1, ng);
+    phi.setVal(0.0);
+    FFTPoisson fft(geom, FFTPoisson::BC::open);
+    fft.solve(phi, rhs);
+
+    MultiFab::Subtract(phi, exact, 0, 0, 1, ng);
+    return phi.norm0(0, ng) / exact.norm0(0, ng);
+}
+
+Real test_open_ghost (int n_cell, int max_grid_size)
+{
+    // The ghost cells must be the same as the valid cells of the solution
+    // on a domain grown by the number of ghost cells.
+    const int ng = 2;
+    const Box domain(IntVect(0), IntVect(n_cell-1));
+    const Real h = 1.0/n_cell;
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    RealBox rb_big({AMREX_D_DECL(-ng*h,-ng*h,-ng*h)}, {AMREX_D_DECL(1.+ng*h,1.+ng*h,1.+ng*h)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+    Geometry geom(domain, rb, CoordSys::cartesian, is_periodic);
+    Geometry geom_big(amrex::grow(domain,ng), rb_big, CoordSys::cartesian, is_periodic);
+
+    BoxArray ba(domain);
+    ba.maxSize(max_grid_size);
+    DistributionMapping dm(ba);
+    BoxArray ba_big(amrex::grow(domain,ng));
+    ba_big.maxSize(max_grid_size);
+    DistributionMapping dm_big(ba_big);
+
+    // A random charge, so that the cells next to the boundary matter
+    MultiFab rhs(ba, dm, 1, 0);
+    for (MFIter mfi(rhs); mfi.isValid(); ++mfi) {
+        Array4<Real> const& r = rhs.array(mfi);
+        LoopOnCpu(mfi.validbox(), [=] (int i, int j, int k) noexcept
+        {
+            r(i,j,k) = amrex::Random() - 0.5;
+        });
+    }
+    MultiFab rhs_big(ba_big, dm_big, 1, 0);
+    rhs_big.setVal(0.0);
+    rhs_big.ParallelCopy(rhs);
+
+    MultiFab phi(ba, dm, 1, ng);
+    phi.setVal(0.0);
+    FFTPoisson fft(geom, FFTPoisson::BC::open);
+    fft.solve(phi, rhs);
+
+    MultiFab phi_big(ba_big, dm_big, 1, 0);
+    FFTPoisson fft_big(geom_big, FFTPoisson::BC::open);
+    fft_big.solve(phi_big, rhs_big);
+
+    MultiFab phi2(ba, dm, 1, ng);
+    phi2.ParallelCopy(phi_big, 0, 0, 1, 0, ng);
+    MultiFab::Subtract(phi2, phi, 0, 0, 1, ng);
+    return phi2.norm0(0, ng) / phi.norm0(0, ng);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        Real sigma = 0.15;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("sigma", sigma);
+        }
+
+        const Real err_periodic = test_periodic(n_cell, max_grid_size);
+        amrex::Print() << "Periodic: relative difference from MLPoisson " << err_periodic << "\n";
+
+        bool pass = err_periodic < 1.e-9;
+
+#if (AMREX_SPACEDIM == 3)
+        // The error is that of the discretization, so it has to converge.
+        const Real err_open_c = test_open(n_cell  , max_grid_size, sigma);
+        const Real err_open_f = test_open(n_cell*2, max_grid_size, sigma);
+        amrex::Print() << "Open: relative error including ghost cells " << err_open_c
+                       << " and " << err_open_f << " with twice the resolution\n";
+        pass = pass && err_open_f < 5.e-3 && err_open_f < err_open_c/3.;
+
+        const Real err_ghost = test_open_ghost(n_cell, max_grid_size);
+        amrex::Print() << "Open: relative difference of the ghost cells from a larger domain "
+                       << err_ghost << "\n";
+        pass = pass && err_ghost < 1.e-12;
+#endif
+
+        if (!pass) {
+            amrex::Abort("FFTPoisson test failed");
+        }
+        amrex::Print() << "FFTPoisson test passed\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,168 @@
+//
+// Tests MLKrylovSolver.  A variable coefficient problem with high contrast
+// inclusions is solved with MLMG, and with FGMRES and PCG preconditioned by
+// MLMG V-cycles.  The Krylov solvers must converge to the tolerance, give
+// the MLMG solution, and leave the bottom solver of the MLMG unchanged.
+//
+
+#include <cmath>
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_MLABecLaplacian.H>
+#include <AMReX_MLMG.H>
+#include <AMReX_MLKrylovSolver.H>
+
+using namespace amrex;
+
+namespace {
+
+const Real pi = 3.14159265358979323846;
+
+Real rel_diff (const MultiFab& a, const MultiFab& b)
+{
+    MultiFab d(a.boxArray(), a.DistributionMap(), 1, 0);
+    MultiFab::LinComb(d, 1.0, a, 0, -1.0, b, 0, 0, 1, 0);
+    return d.norm0() / a.norm0();
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        Real contrast = 100.;
+        Real tol_rel = 1.e-10;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("contrast", contrast);
+            pp.query("tol_rel", tol_rel);
+        }
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+        Geometry geom(domain, rb, CoordSys::cartesian, is_periodic);
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        const auto dx = geom.CellSizeArray();
+
+        MultiFab rhs(ba, dm, 1, 0);
+        for (MFIter mfi(rhs); mfi.isValid(); ++mfi)
+        {
+            Array4<Real> const& r = rhs.array(mfi);
+            LoopOnCpu(mfi.validbox(), [=] (int i, int j, int k) noexcept
+            {
+                Real x = (i+0.5)*dx[0];
+                Real y = (j+0.5)*dx[1];
+#if (AMREX_SPACEDIM == 3)
+                Real z = (k+0.5)*dx[2];
+#else
+                Real z = 0.5; amrex::ignore_unused(k);
+#endif
+                r(i,j,k) = std::sin(pi*x) * std::sin(2.*pi*y) * std::sin(pi*z) + 0.5;
+            });
+        }
+
+        // b is contrast in a lattice of small cubes and 1 elsewhere
+        Array<MultiFab,AMREX_SPACEDIM> bcoef;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+        {
+            const BoxArray& fba = amrex::convert(ba, IntVect::TheDimensionVector(idim));
+            bcoef[idim].define(fba, dm, 1, 0);
+            for (MFIter mfi(bcoef[idim]); mfi.isValid(); ++mfi)
+            {
+                Array4<Real> const& b = bcoef[idim].array(mfi);
+                const IntVect ixt = fba.ixType().toIntVect();
+                LoopOnCpu(mfi.validbox(), [=] (int i, int j, int k) noexcept
+                {
+                    const Real x[] = {AMREX_D_DECL((i+0.5*(1-ixt[0]))*dx[0],
+                                                   (j+0.5*(1-ixt[1]))*dx[1],
+                                                   (k+0.5*(1-ixt[2]))*dx[2])};
+                    bool inside = true;
+                    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                        const Real f = x[d]*5. - std::floor(x[d]*5.);
+                        inside = inside && f > 0.3 && f < 0.7;
+                    }
+                    b(i,j,k) = inside ? contrast : 1.0;
+                });
+            }
+        }
+
+        MLABecLaplacian mlabec({geom}, {ba}, {dm});
+        mlabec.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                         LinOpBCType::Dirichlet,
+                                         LinOpBCType::Dirichlet)},
+                           {AMREX_D_DECL(LinOpBCType::Neumann,
+                                         LinOpBCType::Dirichlet,
+                                         LinOpBCType::Dirichlet)});
+        mlabec.setLevelBC(0, nullptr);
+        mlabec.setScalars(0.0, 1.0);
+        mlabec.setBCoeffs(0, amrex::GetArrOfConstPtrs(bcoef));
+
+        Real max_err = 0.0;
+        bool ok = true;
+
+        MultiFab phi_mg(ba, dm, 1, 1);
+        phi_mg.setVal(0.0);
+        int mlmg_iters;
+        {
+            MLMG mlmg(mlabec);
+            mlmg.setMaxIter(200);
+            mlmg.solve({&phi_mg}, {&rhs}, tol_rel, 0.0);
+            mlmg_iters = mlmg.getNumIters();
+            amrex::Print() << "MLMG: " << mlmg_iters << " iterations\n";
+        }
+
+        const std::string names[] = {"FGMRES", "PCG"};
+        const MLKrylovSolver::Type types[] = {MLKrylovSolver::Type::fgmres,
+                                              MLKrylovSolver::Type::pcg};
+        for (int it = 0; it < 2; ++it)
+        {
+            MultiFab phi(ba, dm, 1, 1);
+            phi.setVal(0.0);
+
+            MLMG mlmg(mlabec);
+            MLKrylovSolver krylov(mlmg, types[it]);
+            krylov.setMaxIter(200);
+            const Real resid = krylov.solve(phi, rhs, tol_rel, 0.0);
+
+            const Real bnorm = std::sqrt(MultiFab::Dot(rhs, 0, rhs, 0, 1, 0));
+            const Real err = rel_diff(phi_mg, phi);
+            amrex::Print() << names[it] << ": " << krylov.getNumIters()
+                           << " iterations, resid/bnorm = " << resid/bnorm
+                           << ", relative difference with MLMG " << err << "\n";
+            max_err = std::max(max_err, err);
+
+            // the returned residual is the true residual of the solution, which
+            // may be slightly larger than the residual of the iterations
+            ok = ok && resid <= 2.0*tol_rel*bnorm;
+            // each iteration is a V-cycle, and the Krylov acceleration pays off
+            ok = ok && krylov.getNumIters() > 0 && krylov.getNumIters() < mlmg_iters;
+
+            // the MLMG object is unchanged and can still be used
+            ok = ok && mlmg.getBottomSolver() == BottomSolver::Default;
+            MultiFab phi2(ba, dm, 1, 1);
+            phi2.setVal(0.0);
+            mlmg.setMaxIter(200);
+            mlmg.solve({&phi2}, {&rhs}, tol_rel, 0.0);
+            max_err = std::max(max_err, rel_diff(phi_mg, phi2));
+        }
+
+        amrex::Print() << "max relative difference: " << max_err << "\n";
+        if (!ok || max_err > 1.e-7) {
+            amrex::Abort("KrylovSolver failed");
+        }
+        amrex::Print() << "KrylovSolver passed\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,191 @@
+//
+// Checks the constant-sigma nodal Laplacian kernels (mlndlap_*_c) used by
+// MLNodeLaplacian::setConstantSigma against the variable-sigma kernels
+// (mlndlap_*_aa) evaluated with a constant sigma field.
+//
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_iMultiFab.H>
+#include <AMReX_MLNodeLap_K.H>
+
+using namespace amrex;
+
+namespace {
+
+Real rel_diff (const MultiFab& a, const MultiFab& b)
+{
+    MultiFab d(a.boxArray(), a.DistributionMap(), 1, 0);
+    MultiFab::LinComb(d, 1.0, a, 0, -1.0, b, 0, 0, 1, 0);
+    return d.norm0() / std::max(a.norm0(), std::numeric_limits<Real>::min());
+}
+
+void fill_random (MultiFab& mf)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        Array4<Real> const& a = mf.array(mfi);
+        LoopOnCpu(mfi.fabbox(), [=] (int i, int j, int k) noexcept
+        {
+            a(i,j,k) = amrex::Random() - 0.5;
+        });
+    }
+}
+
+void check (const std::string& name, const MultiFab& a, const MultiFab& b, Real& max_err)
+{
+    const Real err = rel_diff(a, b);
+    amrex::Print() << "  " << name << ": relative difference " << err << "\n";
+    max_err = std::max(max_err, err);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        Real sigma = 2.5;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("sigma", sigma);
+        }
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        BoxArray cba(domain);
+        cba.maxSize(max_grid_size);
+        DistributionMapping dm(cba);
+        const BoxArray nba = amrex::convert(cba, IntVect::TheNodeVector());
+
+        // Anisotropic cell size so that the x, y and z coefficients differ
+        GpuArray<Real,AMREX_SPACEDIM> dxinv;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            dxinv[idim] = n_cell * (1.0 + 0.25*idim);
+        }
+
+        MultiFab sig(cba, dm, 1, 1);
+        sig.setVal(sigma);
+
+        // Mask out the domain boundary nodes, as for Dirichlet boundaries.
+        const Box nddom = amrex::surroundingNodes(domain);
+        iMultiFab msk(nba, dm, 1, 1);
+        for (MFIter mfi(msk); mfi.isValid(); ++mfi) {
+            Array4<int> const& m = msk.array(mfi);
+            const Box& inner = amrex::grow(nddom, -1);
+            LoopOnCpu(mfi.fabbox(), [=] (int i, int j, int k) noexcept
+            {
+                m(i,j,k) = inner.contains(IntVect(AMREX_D_DECL(i,j,k))) ? 0 : 1;
+            });
+        }
+
+        MultiFab x(nba, dm, 1, 1), rhs(nba, dm, 1, 0);
+        fill_random(x);
+        fill_random(rhs);
+
+        Real max_err = 0.0;
+
+        // A x
+        MultiFab y_aa(nba, dm, 1, 0), y_c(nba, dm, 1, 0);
+        for (MFIter mfi(x); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            Array4<Real const> const& xarr = x.const_array(mfi);
+            Array4<Real const> const& sarr = sig.const_array(mfi);
+            Array4<int const> const& marr = msk.const_array(mfi);
+            Array4<Real> const& yaa = y_aa.array(mfi);
+            Array4<Real> const& yc = y_c.array(mfi);
+            LoopOnCpu(bx, [=] (int i, int j, int k) noexcept
+            {
+#if (AMREX_SPACEDIM == 2)
+                mlndlap_adotx_aa(i,j,k,yaa,xarr,sarr,marr,false,dxinv);
+                mlndlap_adotx_c (i,j,k,yc ,xarr,sigma,marr,false,dxinv);
+#else
+                mlndlap_adotx_aa(i,j,k,yaa,xarr,sarr,marr,dxinv);
+                mlndlap_adotx_c (i,j,k,yc ,xarr,sigma,marr,dxinv);
+#endif
+            });
+        }
+        check("adotx", y_aa, y_c, max_err);
+
+        // Jacobi, from the same A x
+        MultiFab s_aa(nba, dm, 1, 1), s_c(nba, dm, 1, 1);
+        MultiFab::Copy(s_aa, x, 0, 0, 1, 1);
+        MultiFab::Copy(s_c , x, 0, 0, 1, 1);
+        for (MFIter mfi(x); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            mlndlap_jacobi_aa(bx, s_aa.array(mfi), y_aa.const_array(mfi), rhs.const_array(mfi),
+                              sig.const_array(mfi), msk.const_array(mfi), dxinv);
+            mlndlap_jacobi_c (bx, s_c.array(mfi), y_aa.const_array(mfi), rhs.const_array(mfi),
+                              sigma, msk.const_array(mfi), dxinv);
+        }
+        check("jacobi", s_aa, s_c, max_err);
+
+        // Gauss-Seidel, from the same initial guess
+        MultiFab::Copy(s_aa, x, 0, 0, 1, 1);
+        MultiFab::Copy(s_c , x, 0, 0, 1, 1);
+        for (MFIter mfi(x); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+#if (AMREX_SPACEDIM == 2)
+            mlndlap_gauss_seidel_aa(bx, s_aa.array(mfi), rhs.const_array(mfi), sig.const_array(mfi),
+                                    msk.const_array(mfi), dxinv, false);
+            mlndlap_gauss_seidel_c (bx, s_c.array(mfi), rhs.const_array(mfi), sigma,
+                                    msk.const_array(mfi), dxinv, false);
+#else
+            mlndlap_gauss_seidel_aa(bx, s_aa.array(mfi), rhs.const_array(mfi), sig.const_array(mfi),
+                                    msk.const_array(mfi), dxinv);
+            mlndlap_gauss_seidel_c (bx, s_c.array(mfi), rhs.const_array(mfi), sigma,
+                                    msk.const_array(mfi), dxinv);
+#endif
+        }
+        check("gauss_seidel", s_aa, s_c, max_err);
+
+        // Normalize
+        MultiFab::Copy(s_aa, x, 0, 0, 1, 0);
+        MultiFab::Copy(s_c , x, 0, 0, 1, 0);
+        for (MFIter mfi(x); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            mlndlap_normalize_aa(bx, s_aa.array(mfi), sig.const_array(mfi),
+                                 msk.const_array(mfi), dxinv);
+            mlndlap_normalize_c (bx, s_c.array(mfi), sigma, msk.const_array(mfi), dxinv);
+        }
+        check("normalize", s_aa, s_c, max_err);
+
+        // Interpolation from the coarsened grid, with sigma on the fine cells
+        {
+            const BoxArray cnba = amrex::coarsen(nba, 2);
+            MultiFab crse(cnba, dm, 1, 1);
+            fill_random(crse);
+            MultiFab f_aa(nba, dm, 1, 0), f_c(nba, dm, 1, 0);
+            f_aa.setVal(0.0);
+            f_c.setVal(0.0);
+            for (MFIter mfi(f_aa); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.validbox();
+                Array4<Real const> const& carr = crse.const_array(mfi);
+                Array4<Real const> const& sarr = sig.const_array(mfi);
+                Array4<int const> const& marr = msk.const_array(mfi);
+                Array4<Real> const& faa = f_aa.array(mfi);
+                Array4<Real> const& fc = f_c.array(mfi);
+                LoopOnCpu(bx, [=] (int i, int j, int k) noexcept
+                {
+                    mlndlap_interpadd_aa(i,j,k,faa,carr,sarr,marr);
+                    mlndlap_interpadd_c (i,j,k,fc ,carr,marr);
+                });
+            }
+            check("interpadd", f_aa, f_c, max_err);
+        }
+
+        if (max_err > 1.e-13) {
+            amrex::Abort("NodeConstSigma: constant-sigma kernels differ from the _aa kernels");
+        }
+        amrex::Print() << "NodeConstSigma passed\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,159 @@
+// --------------------------------------------------------------------
+// main.cpp
+// --------------------------------------------------------------------
+//   this file does the following:
+//     tags a level the way AmrMesh::MakeNewGrids does (buffering,
+//     coarsening by the blocking factor, mapping through the periodic
+//     boundary), clusters the tags with ParallelCluster and with a serial
+//     ClusterList on all the tags, and checks that the boxes of
+//     ParallelCluster cover all the tags with the required efficiency.
+// --------------------------------------------------------------------
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_TagBox.H>
+#include <AMReX_Cluster.H>
+
+using namespace amrex;
+
+namespace {
+
+// Returns the number of tags in the boxes, which must be disjoint.
+Long NumTagsIn (const BoxList& bl, const Vector<IntVect>& tags)
+{
+    const BoxArray ba(bl);
+    Long n = 0;
+    for (const IntVect& iv : tags) {
+        if (ba.contains(iv)) ++n;
+    }
+    return n;
+}
+
+Real Efficiency (const BoxList& bl, const Vector<IntVect>& tags)
+{
+    return static_cast<Real>(NumTagsIn(bl, tags)) / static_cast<Real>(BoxArray(bl).numPts());
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 16;
+        int n_error_buf = 2;
+        int blocking_factor = 4;
+        Real grid_eff = 0.7;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("n_error_buf", n_error_buf);
+            pp.query("blocking_factor", blocking_factor);
+            pp.query("grid_eff", grid_eff);
+        }
+
+        // periodic in x only
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,0,0)};
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        const IntVect nbuf(n_error_buf);
+        TagBoxArray tags(ba, dm, nbuf);
+        tags.setVal(TagBox::CLEAR);
+
+        // two shells, one of them across the periodic boundary, and a slab
+        for (MFIter mfi(tags); mfi.isValid(); ++mfi)
+        {
+            Array4<char> const& t = tags.array(mfi);
+            const Real h = 1.0/n_cell;
+            LoopOnCpu(mfi.validbox(), [=] (int i, int j, int k) noexcept
+            {
+                const Real x = (i+0.5)*h, y = (j+0.5)*h;
+#if (AMREX_SPACEDIM == 3)
+                const Real z = (k+0.5)*h;
+#else
+                const Real z = 0.5;
+#endif
+                const Real r1 = std::sqrt((x-0.3)*(x-0.3) + (y-0.4)*(y-0.4) + (z-0.5)*(z-0.5));
+                const Real xp = std::min(x, 1.0-x);
+                const Real r2 = std::sqrt(xp*xp + (y-0.7)*(y-0.7) + (z-0.3)*(z-0.3));
+                if (std::abs(r1-0.2) < 1.5*h || std::abs(r2-0.15) < 1.5*h ||
+                    (std::abs(y-0.15) < h && x > 0.5))
+                {
+                    t(i,j,k) = TagBox::SET;
+                }
+            });
+        }
+
+        tags.buffer(nbuf);
+        tags.coarsen(IntVect(blocking_factor));
+        const Box cdomain = amrex::coarsen(domain, blocking_factor);
+        Geometry cgeom(cdomain, rb, CoordSys::cartesian, is_periodic);
+        tags.mapPeriodic(cgeom);
+
+        // clear the tags outside the domain
+        for (MFIter mfi(tags); mfi.isValid(); ++mfi)
+        {
+            for (const Box& b : amrex::boxDiff(mfi.fabbox(), cdomain)) {
+                tags[mfi].setVal<RunOn::Host>(TagBox::CLEAR, b, 0);
+            }
+        }
+
+        BoxDomain bd;
+        bd.add(cdomain);
+
+        // serial clustering of all the tags
+        Vector<IntVect> all_tags;
+        tags.collate(all_tags);
+        ClusterList clist(all_tags.data(), all_tags.size());
+        clist.chop(grid_eff);
+        clist.intersect(bd);
+        BoxList serial_bl;
+        clist.boxList(serial_bl);
+        // all_tags was reordered
+        tags.collate(all_tags);
+
+        // distributed clustering, with the overlapping TagBoxes
+        Long ndup = 0;
+        {
+            Vector<IntVect> local_tags;
+            tags.local_collate(local_tags);
+            ndup = local_tags.size();
+            ParallelDescriptor::ReduceLongSum(ndup);
+            ndup -= all_tags.size();
+        }
+        tags.removeDuplicates();
+        Vector<IntVect> local_tags;
+        tags.local_collate(local_tags);
+        Long nlocal = local_tags.size();
+        ParallelDescriptor::ReduceLongSum(nlocal);
+
+        BoxList parallel_bl = ParallelCluster(local_tags, grid_eff, false, bd);
+
+        const Real serial_eff = Efficiency(serial_bl, all_tags);
+        const Real parallel_eff = Efficiency(parallel_bl, all_tags);
+
+        amrex::Print() << "tags: " << all_tags.size()
+                       << ", duplicated before removeDuplicates: " << ndup
+                       << ", after: " << nlocal - static_cast<Long>(all_tags.size()) << "\n"
+                       << "serial:   " << serial_bl.size() << " boxes, efficiency "
+                       << serial_eff << "\n"
+                       << "parallel: " << parallel_bl.size() << " boxes, efficiency "
+                       << parallel_eff << "\n";
+
+        bool ok = nlocal == static_cast<Long>(all_tags.size());
+        ok = ok && BoxArray(parallel_bl).isDisjoint();
+        ok = ok && NumTagsIn(parallel_bl, all_tags) == static_cast<Long>(all_tags.size());
+        ok = ok && parallel_eff >= grid_eff;
+        if (!ok) {
+            amrex::Abort("ParallelCluster failed");
+        }
+        amrex::Print() << "ParallelCluster passed\n";
+    }
+    amrex::Finalize();
+}
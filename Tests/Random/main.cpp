@@ -0,0 +1,105 @@
+//
+// Known-answer tests for the counter-based random numbers.  Philox4x32 is
+// checked against the Philox4x32-10 vectors of Random123, and RandomUniform,
+// RandomNormal and FillRandom against values recorded when they were added,
+// so that a change of the streams cannot go unnoticed.
+//
+
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Random.H>
+
+using namespace amrex;
+
+namespace {
+
+bool check_philox (std::uint32_t c0, std::uint32_t c1, std::uint32_t c2, std::uint32_t c3,
+                   std::uint32_t k0, std::uint32_t k1,
+                   std::uint32_t r0, std::uint32_t r1, std::uint32_t r2, std::uint32_t r3)
+{
+    std::uint32_t ctr[4] = {c0, c1, c2, c3};
+    const std::uint32_t key[2] = {k0, k1};
+    amrex::Philox4x32(ctr, key);
+    const bool ok = ctr[0] == r0 && ctr[1] == r1 && ctr[2] == r2 && ctr[3] == r3;
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "Philox4x32-10: %08x %08x %08x %08x %s\n",
+                  ctr[0], ctr[1], ctr[2], ctr[3], ok ? "ok" : "WRONG");
+    amrex::Print() << buf;
+    return ok;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        bool ok = true;
+
+        // Random123 kat_vectors
+        ok = check_philox(0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u,
+                          0x00000000u, 0x00000000u,
+                          0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u) && ok;
+        ok = check_philox(0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu,
+                          0xffffffffu, 0xffffffffu,
+                          0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu) && ok;
+        ok = check_philox(0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u,
+                          0xa4093822u, 0x299f31d0u,
+                          0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u) && ok;
+
+        // the conversions to uniform and normal numbers, and the cell ids
+        {
+            const Real u = amrex::RandomUniform(12345, 678, 9, 1);
+            const Real g = amrex::RandomNormal(0.0, 1.0, 12345, 678, 9, 1);
+            const ULong id = amrex::RandomCellId(-3, 5, 7);
+            amrex::Print().SetPrecision(17) << "RandomUniform: " << u << "\n"
+                                            << "RandomNormal:  " << g << "\n"
+                                            << "RandomCellId:  " << id << "\n";
+            ok = ok && u == 0.84418378701103569;
+            // std::log and std::cos may differ in the last bit
+            ok = ok && std::abs(g - (-0.35261447591890216)) < 1.e-15;
+            ok = ok && id == 4611719003787755517ULL;
+        }
+
+        // FillRandom does not depend on the BoxArray or the DistributionMapping
+        {
+            const Box domain(IntVect(0), IntVect(31));
+            BoxArray ba1(domain);
+            ba1.maxSize(16);
+            BoxArray ba2(domain);
+            ba2.maxSize(8);
+            MultiFab mf1(ba1, DistributionMapping(ba1), 2, 1);
+            MultiFab mf2(ba2, DistributionMapping(ba2), 2, 1);
+            amrex::FillRandom(mf1, 0, 2, 12345, 9, 1);
+            amrex::FillRandom(mf2, 0, 2, 12345, 9, 1);
+            MultiFab mf3(ba1, mf1.DistributionMap(), 2, 0);
+            mf3.ParallelCopy(mf2, 0, 0, 2);
+            MultiFab::Subtract(mf3, mf1, 0, 0, 2, 0);
+            const Real d = std::max(mf3.norm0(0), mf3.norm0(1));
+            amrex::Print() << "FillRandom decomposition difference: " << d << "\n";
+            ok = ok && d == 0.0;
+
+            Real v = 0.0;
+            for (MFIter mfi(mf1); mfi.isValid(); ++mfi) {
+                const Box& gbx = mfi.fabbox();
+                const IntVect iv(AMREX_D_DECL(-1,5,7));
+                if (gbx.contains(iv) && mfi.validbox().contains(IntVect(AMREX_D_DECL(0,5,7)))) {
+                    v = mf1[mfi](iv, 1);
+                }
+            }
+            ParallelDescriptor::ReduceRealSum(v);
+            ok = ok && v == amrex::RandomUniform(12345, amrex::RandomCellId(-1,5,7), 9, 1);
+        }
+
+        if (!ok) {
+            amrex::Abort("Random failed");
+        }
+        amrex::Print() << "Random passed\n";
+    }
+    amrex::Finalize();
+}
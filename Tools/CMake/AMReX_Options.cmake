@@ -197,6 +197,11 @@ cmake_dependent_option(ENABLE_PETSC "Enable PETSc interfaces" OFF
    "ENABLE_LINEAR_SOLVERS" OFF )
 print_option(ENABLE_PETSC)
 
+# FFTW
+cmake_dependent_option(ENABLE_FFTW "Use FFTW in the FFT Poisson solver" OFF
+   "ENABLE_LINEAR_SOLVERS" OFF)
+print_option(ENABLE_FFTW)
+
 # HDF5
 option(ENABLE_HDF5 "Enable HDF5-based I/O" OFF)
 print_option(ENABLE_HDF5)
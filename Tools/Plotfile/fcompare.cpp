@@ -36,6 +36,7 @@ int main_main()
     std::string zone_info_var_name;
     Vector<std::string> plot_names(1);
     bool abort_if_not_all_found = false;
+    bool exit_early = false;
 
     int farg = 1;
     while (farg <= narg) {
@@ -58,6 +59,8 @@ int main_main()
             rtol = std::stod(amrex::get_command_argument(++farg));
         } else if (fname == "--abort_if_not_all_found") {
             abort_if_not_all_found = true;            
+        } else if (fname == "-e" or fname == "--exit_early") {
+            exit_early = true;
         } else {
             break;
         }
@@ -79,7 +82,7 @@ int main_main()
             << " variable.\n"
             << "\n"
             << " usage:\n"
-            << "    fcompare [-g|--ghost] [-n|--norm num] [-d|--diffvar var] [-z|--zone_info var] [-a|--allow_diff_grids] [-r|rel_tol] file1 file2\n"
+            << "    fcompare [-g|--ghost] [-n|--norm num] [-d|--diffvar var] [-z|--zone_info var] [-a|--allow_diff_grids] [-r|rel_tol] [-e|--exit_early] file1 file2\n"
             << "\n"
             << " optional arguments:\n"
             << "    -g|--ghost            : compare the ghost cells too (if stored)\n"
@@ -90,13 +93,14 @@ int main_main()
             << "                            to the maximum error for the given variable\n"
             << "    -a|--allow_diff_grids : allow different BoxArrays covering the same domain\n"
             << "    -r|--rel_tol rtol     : relative tolerance (default is 0)\n"
+            << "    -e|--exit_early       : stop as soon as the files are known to differ\n"
+            << "                            (ignored with -d or -z)\n"
             << std::endl;
         return 0;
     }
 
     PlotFileData pf_a(plotfile_a);
     PlotFileData pf_b(plotfile_b);
-    pf_b.syncDistributionMap(pf_a);
 
     const int dm = pf_a.spaceDim();
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE(pf_a.spaceDim() == pf_b.spaceDim(),
@@ -178,19 +182,29 @@ int main_main()
                    << "  " << std::setw(24) << "(||A - B||/||A||)" << "\n"
                    << " " << std::string(76,'-') << "\n";
 
-    // go level-by-level and patch-by-patch and compare the data
-    for (int ilev = 0; ilev < nlevels; ++ilev)
+    if (save_var_a >= 0 or zone_info) {
+        exit_early = false;
+    }
+    bool exited_early = false;
+
+    // go level-by-level and patch-by-patch and compare the data.  The data
+    // are streamed: only one component of one FAB from each plotfile is in
+    // memory at a time.
+    const int myproc = ParallelDescriptor::MyProc();
+    for (int ilev = 0; ilev < nlevels and !exited_early; ++ilev)
     {
-        if (pf_a.boxArray(ilev).empty() && pf_b.boxArray(ilev).empty()) {
+        const BoxArray& ba_a = pf_a.boxArray(ilev);
+        const BoxArray& ba_b = pf_b.boxArray(ilev);
+        const DistributionMapping& dmap_a = pf_a.DistributionMap(ilev);
+        if (ba_a.empty() && ba_b.empty()) {
             continue;
         }
-        bool grids_match = pf_a.boxArray(ilev) == pf_b.boxArray(ilev);
+        bool grids_match = ba_a == ba_b;
         if (!grids_match && !allow_diff_grids) {
             amrex::Abort("ERROR: grids do not match");
         } else if (!grids_match) {
             // do they cover the same domain?
-            if (!pf_a.boxArray(ilev).contains(pf_b.boxArray(ilev)) ||
-                !pf_a.boxArray(ilev).contains(pf_b.boxArray(ilev))) {
+            if (!ba_a.contains(ba_b) || !ba_b.contains(ba_a)) {
                 amrex::Abort("ERROR: grids do not cover same domain");
             }
         }
@@ -200,71 +214,141 @@ int main_main()
         Vector<Real> rerror_denom(ncomp_a, 0.0);
         Vector<int> has_nan_a(ncomp_a, false);
         Vector<int> has_nan_b(ncomp_a, false);
-        for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
-            if (ivar_b[icomp_a] >= 0) {
-                const MultiFab& mf_a = pf_a.get(ilev, names_a[icomp_a]);
-                MultiFab mf_b;
+        Vector<int> compared(ncomp_a, false);
+        Vector<int> partial(ncomp_a, false);
+        for (int icomp_a = 0; icomp_a < ncomp_a and !exited_early; ++icomp_a) {
+            if (ivar_b[icomp_a] < 0) {
+                continue;
+            }
+            const std::string& name_a = names_a[icomp_a];
+            const std::string& name_b = names_b[ivar_b[icomp_a]];
+
+            // [0]: max |B-A|, [1]: max |A|, [2]: sum |B-A|, [3]: sum |A|,
+            // [4]: sum |B-A|^2, [5]: sum |A|^2
+            Array<Real,6> r {{0.0, 0.0, 0.0, 0.0, 0.0, 0.0}};
+            bool nan_a = false;
+            bool nan_b = false;
+            bool stopped = false;
+            ErrZone zone;
+            zone.grid_index = -1;
+
+            for (int gid = 0, ngrids = ba_a.size(); gid < ngrids; ++gid) {
+                if (dmap_a[gid] != myproc) continue;
+
+                const Box& bx = ba_a[gid];
+                std::unique_ptr<FArrayBox> fab_a = pf_a.getFab(ilev, gid, name_a, bx);
+                std::unique_ptr<FArrayBox> fab_b;
                 if (grids_match) {
-                    mf_b = pf_b.get(ilev, names_b[ivar_b[icomp_a]]);
-                } else {
-                    mf_b.define(mf_a.boxArray(), mf_a.DistributionMap(), 1, 0);
-                    MultiFab tmp = pf_b.get(ilev, names_b[ivar_b[icomp_a]]);
-                    mf_b.ParallelCopy(tmp);
-                }
-                has_nan_a[icomp_a] = mf_a.contains_nan();
-                has_nan_b[icomp_a] = mf_b.contains_nan();
-                MultiFab::Subtract(mf_b,mf_a,0,0,1,0); // b = b - a
-                Real max_err = mf_b.norm0();
-                if (norm == 1) {
-                    aerror[icomp_a] = mf_b.norm1();
-                    rerror[icomp_a] = aerror[icomp_a];
-                    rerror_denom[icomp_a] = mf_a.norm1();
-                } else if (norm == 2) {
-                    aerror[icomp_a] = mf_b.norm2();
-                    rerror[icomp_a] = aerror[icomp_a];
-                    rerror_denom[icomp_a] = mf_a.norm2();
+                    fab_b = pf_b.getFab(ilev, gid, name_b, bx);
                 } else {
-                    aerror[icomp_a] = max_err;
-                    rerror[icomp_a] = aerror[icomp_a];
-                    rerror_denom[icomp_a] = mf_a.norm0();
+                    fab_b.reset(new FArrayBox(bx,1));
+                    for (auto const& is : ba_b.intersections(bx)) {
+                        std::unique_ptr<FArrayBox> part = pf_b.getFab(ilev, is.first, name_b, is.second);
+                        fab_b->copy<RunOn::Host>(*part, is.second, 0, is.second, 0, 1);
+                    }
                 }
 
-                if (norm == 0) {
-                    rerror[icomp_a] /= rerror_denom[icomp_a];
-                } else {
-                    const auto& dx = pf_a.cellSize(ilev);
-                    Real dv = 1.0;
-                    for (int idim = 0; idim < dm; ++idim) {
-                        dv *= dx[idim];
+                const auto& fa = fab_a->const_array();
+                const auto& fb = fab_b->array();
+                amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+                {
+                    const Real va = fa(i,j,k);
+                    const Real vb = fb(i,j,k);
+                    nan_a = nan_a or std::isnan(va);
+                    nan_b = nan_b or std::isnan(vb);
+                    const Real d = std::abs(vb-va);
+                    if (d > r[0]) {
+                        r[0] = d;
+                        zone.cell = IntVect(AMREX_D_DECL(i,j,k));
+                        zone.grid_index = gid;
                     }
-                    aerror[icomp_a] *= std::pow(dv,1./static_cast<Real>(norm));
-                    rerror[icomp_a] = rerror[icomp_a]/rerror_denom[icomp_a];
+                    r[1] = std::max(r[1], std::abs(va));
+                    r[2] += d;
+                    r[3] += std::abs(va);
+                    r[4] += d*d;
+                    r[5] += va*va;
+                    fb(i,j,k) = d;
+                });
+
+                if (icomp_a == save_var_a) {
+                    mf_array[ilev][gid].copy<RunOn::Host>(*fab_b, bx, 0, bx, 0, 1);
                 }
 
-                if (icomp_a == save_var_a or icomp_a == zone_info_var_a) {
-                    mf_b.abs(0,1);
+                // Without a relative tolerance any difference is a failure.
+                if (exit_early and rtol == 0.0 and r[0] > 0.0) {
+                    stopped = true;
+                    break;
                 }
+            }
 
-                if (icomp_a == save_var_a) {
-                    MultiFab::Copy(mf_array[ilev], mf_b, 0, 0, 1, 0);
+            const Real local_max_err = r[0];
+            ParallelDescriptor::ReduceRealMax(r.data(), 2);
+            ParallelDescriptor::ReduceRealSum(r.data()+2, 4);
+            ParallelDescriptor::ReduceBoolOr(nan_a);
+            ParallelDescriptor::ReduceBoolOr(nan_b);
+            ParallelDescriptor::ReduceBoolOr(stopped);
+            has_nan_a[icomp_a] = nan_a;
+            has_nan_b[icomp_a] = nan_b;
+            compared[icomp_a] = true;
+            partial[icomp_a] = stopped;
+
+            const Real max_err = r[0];
+            if (norm == 1) {
+                aerror[icomp_a] = r[2];
+                rerror[icomp_a] = aerror[icomp_a];
+                rerror_denom[icomp_a] = r[3];
+            } else if (norm == 2) {
+                aerror[icomp_a] = std::sqrt(r[4]);
+                rerror[icomp_a] = aerror[icomp_a];
+                rerror_denom[icomp_a] = std::sqrt(r[5]);
+            } else {
+                aerror[icomp_a] = max_err;
+                rerror[icomp_a] = aerror[icomp_a];
+                rerror_denom[icomp_a] = r[1];
+            }
+
+            if (norm == 0) {
+                rerror[icomp_a] /= rerror_denom[icomp_a];
+            } else {
+                const auto& dx = pf_a.cellSize(ilev);
+                Real dv = 1.0;
+                for (int idim = 0; idim < dm; ++idim) {
+                    dv *= dx[idim];
                 }
+                aerror[icomp_a] *= std::pow(dv,1./static_cast<Real>(norm));
+                rerror[icomp_a] = rerror[icomp_a]/rerror_denom[icomp_a];
+            }
 
-                if (icomp_a == zone_info_var_a) {
-                    if (max_err > err_zone.max_abs_err) {
-                        err_zone.max_abs_err = max_err;
-                        err_zone.level = ilev;
-                        err_zone.cell = mf_b.maxIndex(0);
-                        auto isects = pf_a.boxArray(ilev).intersections
-                            (Box(err_zone.cell,err_zone.cell), true, 0);
-                        err_zone.grid_index = isects[0].first;
+            if (icomp_a == zone_info_var_a) {
+                if (max_err > 0.0 and max_err > err_zone.max_abs_err) {
+                    // the lowest rank with the maximum error owns the zone
+                    int owner = (local_max_err == max_err and zone.grid_index >= 0)
+                        ? myproc : ParallelDescriptor::NProcs();
+                    ParallelDescriptor::ReduceIntMin(owner);
+                    Array<int,AMREX_SPACEDIM+1> buf;
+                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                        buf[idim] = zone.cell[idim];
                     }
+                    buf[AMREX_SPACEDIM] = zone.grid_index;
+                    ParallelDescriptor::Bcast(buf.data(), buf.size(), owner);
+                    err_zone.max_abs_err = max_err;
+                    err_zone.level = ilev;
+                    err_zone.cell = IntVect(buf.data());
+                    err_zone.grid_index = buf[AMREX_SPACEDIM];
                 }
             }
+
+            // The result cannot change once a variable fails the tolerance.
+            if (exit_early and aerror[icomp_a] > 0.0 and !(rerror[icomp_a] <= rtol)) {
+                exited_early = true;
+            }
         }
 
         amrex::Print() << " level = " << ilev << "\n";
         for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
-            if (ivar_b[icomp_a] < 0) {
+            if (ivar_b[icomp_a] >= 0 and !compared[icomp_a]) {
+                continue; // skipped by early exit
+            } else if (ivar_b[icomp_a] < 0) {
                 amrex::Print() << " " << std::setw(24) << std::left << names_a[icomp_a]
                                << "  " << std::setw(50)
                                << "< variable not present in both files > \n";
@@ -272,6 +356,10 @@ int main_main()
                 amrex::Print() << " " << std::setw(24) << std::left << names_a[icomp_a]
                                << "  " << std::setw(50)
                                << "< NaN present > \n";
+            } else if (partial[icomp_a]) {
+                // the norms of the data read before stopping are meaningless
+                amrex::Print() << " " << std::setw(24) << std::left << names_a[icomp_a]
+                               << "  < differs, not fully compared >\n";
             } else {
                 Real aerr = 0., rerr = 0.;
                 if (aerror[icomp_a] > 0.) {
@@ -329,9 +417,11 @@ int main_main()
             }
 
             for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
-                const MultiFab& mf = pf_a.get(err_zone.level,names_a[icomp_a]);
                 if (owner_proc) {
-                    Real v = mf[err_zone.grid_index](err_zone.cell);
+                    std::unique_ptr<FArrayBox> fab = pf_a.getFab(err_zone.level, err_zone.grid_index,
+                                                                 names_a[icomp_a],
+                                                                 Box(err_zone.cell,err_zone.cell));
+                    Real v = (*fab)(err_zone.cell);
                     amrex::AllPrint() << " " << std::setw(24)
                                       << names_a[icomp_a] << "  "
                                       << std::setw(24) << std::right
@@ -341,6 +431,11 @@ int main_main()
         }
     }
 
+    if (exited_early) {
+        amrex::Print() << " PLOTFILES DIFFER, remaining data not compared (--exit_early)" << std::endl;
+        return EXIT_FAILURE;
+    }
+
     if (! all_variables_found) {
         amrex::Print() << " WARNING: not all variables present in both files\n";
         if (abort_if_not_all_found) return EXIT_FAILURE;
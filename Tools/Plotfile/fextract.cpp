@@ -175,10 +175,19 @@ void main_main()
             for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
                 ratio[idim] = 1;
             }
-            const iMultiFab mask = makeFineMask(pf.boxArray(ilev), pf.DistributionMap(ilev),
+            // Only the FABs on the line are read.
+            Vector<MultiFab> mfs(var_names.size());
+            for (int ivar = 0; ivar < var_names.size(); ++ivar) {
+                mfs[ivar] = pf.get(ilev, var_names[ivar], slice_box);
+            }
+            if (mfs.empty() or mfs[0].size() == 0) {
+                rr *= ratio;
+                continue;
+            }
+            const iMultiFab mask = makeFineMask(mfs[0].boxArray(), mfs[0].DistributionMap(),
                                                 pf.boxArray(ilev+1), ratio);
             for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                const MultiFab& mf = pf.get(ilev, var_names[ivar]);
+                const MultiFab& mf = mfs[ivar];
                 for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
                     const Box& bx = mfi.validbox() & slice_box;
                     if (bx.ok()) {
@@ -208,7 +217,7 @@ void main_main()
             rr *= ratio;
         } else {
             for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                const MultiFab& mf = pf.get(ilev, var_names[ivar]);
+                const MultiFab& mf = pf.get(ilev, var_names[ivar], slice_box);
                 for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
                     const Box& bx = mfi.validbox() & slice_box;
                     if (bx.ok()) {
@@ -1,7 +1,7 @@
 #include <AMReX.H>
 #include <AMReX_Print.H>
 #include <AMReX_PlotFileUtil.H>
-#include <AMReX_MultiFabUtil.H>
+#include <AMReX_IArrayBox.H>
 #include <algorithm>
 #include <limits>
 #include <cmath>
@@ -58,44 +58,68 @@ void main_main()
             }
         }
 
-        // get the extrema
-        Vector<Real> vvmin(var_names.size());
-        Vector<Real> vvmax(var_names.size());
+        // get the extrema.  The data are streamed one FAB and one variable
+        // at a time, and FABs completely covered by the next finer level are
+        // not read at all.
+        Vector<Real> vvmin(var_names.size(), std::numeric_limits<Real>::max());
+        Vector<Real> vvmax(var_names.size(), std::numeric_limits<Real>::lowest());
 
         const int dim = pf.spaceDim();
+        const int myproc = ParallelDescriptor::MyProc();
 
         for (int ilev = pf.finestLevel(); ilev >= 0; --ilev) {
-            if (ilev == pf.finestLevel()) {
-                for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                    const MultiFab& mf = pf.get(ilev, var_names[ivar]);
-                    vvmin[ivar] = mf.min(0,0,false);
-                    vvmax[ivar] = mf.max(0,0,false);
-                }
-            } else {
+            const BoxArray& ba = pf.boxArray(ilev);
+            const DistributionMapping& dmap = pf.DistributionMap(ilev);
+            BoxArray fine_ba;
+            if (ilev < pf.finestLevel()) {
                 IntVect ratio{pf.refRatio(ilev)};
                 for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
                     ratio[idim] = 1;
                 }
-                iMultiFab mask = makeFineMask(pf.boxArray(ilev), pf.DistributionMap(ilev),
-                                              pf.boxArray(ilev+1), ratio);
+                fine_ba = amrex::coarsen(pf.boxArray(ilev+1), ratio);
+            }
+            for (int gid = 0, ngrids = ba.size(); gid < ngrids; ++gid) {
+                if (dmap[gid] != myproc) continue;
+
+                const Box& bx = ba[gid];
+                std::vector<std::pair<int,Box> > isects;
+                if (!fine_ba.empty()) {
+                    isects = fine_ba.intersections(bx);
+                }
+                Long ncovered = 0;
+                for (auto const& is : isects) {
+                    ncovered += is.second.numPts();
+                }
+                if (ncovered == bx.numPts()) continue;
+
+                IArrayBox mask;
+                if (!isects.empty()) {
+                    mask.resize(bx);
+                    mask.setVal<RunOn::Host>(0);
+                    for (auto const& is : isects) {
+                        mask.setVal<RunOn::Host>(1, is.second);
+                    }
+                }
+
                 for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                    const MultiFab& mf = pf.get(ilev, var_names[ivar]);
-                    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-                        const Box& bx = mfi.validbox();
-                        const auto lo = amrex::lbound(bx);
-                        const auto hi = amrex::ubound(bx);
-                        const auto& ifab = mask.array(mfi);
-                        const auto& fab = mf.array(mfi);
-                        for         (int k = lo.z; k <= hi.z; ++k) {
-                            for     (int j = lo.y; j <= hi.y; ++j) {
-                                for (int i = lo.x; i <= hi.x; ++i) {
-                                    if (ifab(i,j,k) == 0) {
-                                        vvmin[ivar] = std::min(fab(i,j,k),vvmin[ivar]);
-                                        vvmax[ivar] = std::max(fab(i,j,k),vvmax[ivar]);
-                                    }
-                                }
+                    std::unique_ptr<FArrayBox> fab = pf.getFab(ilev, gid, var_names[ivar], bx);
+                    if (isects.empty()) {
+                        vvmin[ivar] = std::min(vvmin[ivar], fab->min<RunOn::Host>(bx,0));
+                        vvmax[ivar] = std::max(vvmax[ivar], fab->max<RunOn::Host>(bx,0));
+                    } else {
+                        const auto& m = mask.const_array();
+                        const auto& a = fab->const_array();
+                        Real mn = vvmin[ivar];
+                        Real mx = vvmax[ivar];
+                        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+                        {
+                            if (m(i,j,k) == 0) { // not covered by fine
+                                mn = std::min(mn, a(i,j,k));
+                                mx = std::max(mx, a(i,j,k));
                             }
-                        }
+                        });
+                        vvmin[ivar] = mn;
+                        vvmax[ivar] = mx;
                     }
                 }
             }
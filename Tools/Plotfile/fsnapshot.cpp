@@ -197,62 +197,54 @@ void main_main()
     Real gmn = std::numeric_limits<Real>::max();
 
     for (int ilev = 0; ilev <= max_level; ++ilev) {
-        const MultiFab& pltmf = pf.get(ilev, compname);
-        gmx = std::max(gmx, pltmf.max(0));
-        gmn = std::min(gmn, pltmf.min(0));
-        if (ilev < max_level) {
-            IntVect ratio{pf.refRatio(ilev)};
-            for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
-                ratio[idim] = 1;
-            }
-            const iMultiFab mask = makeFineMask(pltmf, pf.boxArray(ilev+1), ratio);
-            for (MFIter mfi(pltmf); mfi.isValid(); ++mfi) {
-                const auto& m = mask.array(mfi);
-                const auto& plt = pltmf.array(mfi);
-                const Box& bx = mfi.validbox();
-                IntVect rrlev {rr[ilev]};
+        gmx = std::max(gmx, pf.max(ilev, compname));
+        gmn = std::min(gmn, pf.min(ilev, compname));
+        IntVect rrlev {rr[ilev]};
+        for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
+            rrlev[idim] = 1;
+        }
+        for (int idir = ndir_begin; idir < ndir_end; ++idir) {
+            // Only the part of the level on the slice is read.
+            const Box& crsebox = amrex::coarsen(finebox[idir], rrlev);
+            const MultiFab& pltmf = pf.get(ilev, compname, crsebox);
+            if (pltmf.size() == 0) continue;
+            if (ilev < max_level) {
+                IntVect ratio{pf.refRatio(ilev)};
                 for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
-                    rrlev[idim] = 1;
+                    ratio[idim] = 1;
                 }
-                for (int idir = ndir_begin; idir < ndir_end; ++idir) {
-                    const Box& crsebox = amrex::coarsen(finebox[idir], rrlev);
-                    const Box& ibox = bx & crsebox;
-                    if (ibox.ok()) {
-                        const auto& data = datamf[idir].array(0); // there is only one box
-                        IntVect rrslice = rrlev;
-                        rrslice[idir] = 1;
-                        amrex::For(ibox, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-                        {
-                            if (m(i,j,k) == 0) { // not covered by fine
-                                const Real d = plt(i,j,k);
-                                for         (int koff = 0; koff < rrslice[2]; ++koff) {
-                                    int kk = k*rrlev[2] + koff;
-                                    for     (int joff = 0; joff < rrslice[1]; ++joff) {
-                                        int jj = j*rrlev[1] + joff;
-                                        for (int ioff = 0; ioff < rrslice[0]; ++ioff) {
-                                            int ii = i*rrlev[0] + ioff;
-                                            data(ii,jj,kk) = d;
-                                        }
+                const iMultiFab mask = makeFineMask(pltmf, pf.boxArray(ilev+1), ratio);
+                IntVect rrslice = rrlev;
+                rrslice[idir] = 1;
+                for (MFIter mfi(pltmf); mfi.isValid(); ++mfi) {
+                    const auto& m = mask.array(mfi);
+                    const auto& plt = pltmf.array(mfi);
+                    const auto& data = datamf[idir].array(0); // there is only one box
+                    amrex::For(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+                    {
+                        if (m(i,j,k) == 0) { // not covered by fine
+                            const Real d = plt(i,j,k);
+                            for         (int koff = 0; koff < rrslice[2]; ++koff) {
+                                int kk = k*rrlev[2] + koff;
+                                for     (int joff = 0; joff < rrslice[1]; ++joff) {
+                                    int jj = j*rrlev[1] + joff;
+                                    for (int ioff = 0; ioff < rrslice[0]; ++ioff) {
+                                        int ii = i*rrlev[0] + ioff;
+                                        data(ii,jj,kk) = d;
                                     }
                                 }
                             }
-                        });
-                    }
+                        }
+                    });
                 }
-            }
-        } else {
-            for (MFIter mfi(pltmf); mfi.isValid(); ++mfi) {
-                const auto& plt = pltmf.array(mfi);
-                const Box& bx = mfi.validbox();
-                for (int idir = ndir_begin; idir < ndir_end; ++idir) {
-                    const Box& ibox = bx & finebox[idir];
-                    if (ibox.ok()) {
-                        const auto& data = datamf[idir].array(0); // there is only one box
-                        amrex::ParallelFor(ibox, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-                        {
-                            data(i,j,k) = plt(i,j,k);
-                        });
-                    }
+            } else {
+                for (MFIter mfi(pltmf); mfi.isValid(); ++mfi) {
+                    const auto& plt = pltmf.array(mfi);
+                    const auto& data = datamf[idir].array(0); // there is only one box
+                    amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+                    {
+                        data(i,j,k) = plt(i,j,k);
+                    });
                 }
             }
         }